@@ -35,6 +35,10 @@ void ofApp::setup() {
 	draw_dots = false;
 	start_button_pressed = false;
 	button_pressed_time = 0;
+	plan_ready = false;
+	planning = false;
+	path_ready = false;
+	homing_done = false;
 	current_command_index = 0;
 	estimated_elapsed_time = "";
 	real_elapsed_time = "";
@@ -92,19 +96,8 @@ void ofApp::update(){
 	// 	light_fbo.end();
 	// }
 
-	// Save the time when the button is pressed
-	if (start_button_pressed){
-
-		button_pressed_time = (int) ofGetElapsedTimef();
-		ofLogNotice() << "button pressed at: " << button_pressed_time << " seconds";
-	
-		int elapsed_seconds = (int) ofGetElapsedTimef();
-
-		// wait a bit before sending stuff to serial
-		while (elapsed_seconds < button_pressed_time + SERIAL_INITIAL_DELAY_TIME){
-			// ofLogVerbose() << "elapsed time: " << elapsed_seconds;
-			elapsed_seconds = (int) ofGetElapsedTimef();
-		}
+	// send the machine home a bit after the button is pressed (without waiting for the path, the worker is planning it)
+	if (start_button_pressed && ofGetElapsedTimef() >= button_pressed_time + SERIAL_INITIAL_DELAY_TIME){
 
 		ofLogNotice() << "sending home";
 			
@@ -114,10 +107,13 @@ void ofApp::update(){
 
 		send_osc_bundle(osc_message, cnc_device, 1024);
 
-		draw_dots = true;
+		start_button_pressed = false;
 	}
 
-	start_button_pressed = false;
+	// the worker has finished the portrait
+	if (plan_ready){
+		publish_portrait();
+	}
 }
 
 //--------------------------------------------------------------
@@ -142,6 +138,10 @@ void ofApp::draw(){
 		ofDrawRectangle(face_tracking_rectangle.x, face_tracking_rectangle.y, face_tracking_rectangle.width, face_tracking_rectangle.height);
 		ofPopStyle();
 	}
+	else if (!path_ready){
+		input_image.draw(0,0);
+		ofDrawBitmapStringHighlight("Planning the portrait...", 24, 35);
+	}
 	else {
 		dots_fbo.draw(0, 0);
 		ofPushStyle();
@@ -161,9 +161,93 @@ void ofApp::draw(){
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key){
 
-	if (key == ' '){
+	if (key == ' ' && !draw_dots && !planning){
+		button_pressed_time = ofGetElapsedTimef();
+		ofLogNotice() << "button pressed at: " << button_pressed_time << " seconds";
 		start_button_pressed = true;
-		run_coherent_line_drawing(input_image, output_image, dots_fbo);
+		draw_dots = true;
+		start_portrait();
+	}
+}
+
+//--------------------------------------------------------------
+// PORTRAIT PLANNING
+//--------------------------------------------------------------
+// copies the camera image and runs the coherent line drawing on a worker thread
+//--------------------------------------------------------------
+void ofApp::start_portrait(){
+
+	if (plan_worker.joinable()){
+		plan_worker.join();
+	}
+
+	planning = true;
+	path_ready = false;
+	plan_ready = false;
+	homing_done = false; // the machine is sent home again for each portrait
+
+	// the worker gets its own copy of the image and of the window center
+	ofPixels input_pixels = input_image.getPixels();
+	glm::vec2 center(ofGetWidth()/2, ofGetHeight()/2);
+
+	plan_worker = std::thread([this, input_pixels, center](){
+		run_coherent_line_drawing(input_pixels, next_plan, center);
+		plan_ready = true;
+	});
+}
+
+//--------------------------------------------------------------
+// swaps the plan of the worker with the dots drawn by draw() and sent to the machine,
+// then draws the dots on their fbo (OpenGL, so on the main thread)
+//--------------------------------------------------------------
+void ofApp::publish_portrait(){
+
+	plan_worker.join();
+	plan_ready = false;
+	planning = false;
+
+	dots.swap(next_plan.dots);
+	sorted_dots.swap(next_plan.sorted_dots);
+	estimated_elapsed_time = next_plan.estimated_elapsed_time;
+	output_image.setFromPixels(next_plan.output_pixels);
+
+	dots_fbo.begin();
+	ofSetColor(ofColor::orange);
+	for (auto d : sorted_dots){
+		ofDrawCircle(d.x, d.y, circle_size/2);
+	}
+	dots_fbo.end();
+
+	path_ready = !sorted_dots.empty();
+	ofLogNotice("publish_portrait") << "sorted dots size: " << sorted_dots.size();
+
+	// nothing to paint (no dots sampled): back to the camera, the visitor can try again
+	if (!path_ready){
+		ofLogWarning("publish_portrait") << "the portrait has no dots, back to the camera";
+		draw_dots = false;
+		homing_done = false;
+		return;
+	}
+
+	// the rest of the path keeps improving while the machine paints
+	if (STREAMING_PATH && path_ready){
+		stream_dots = sorted_dots;
+		vector<Point2D> stream_points;
+		toPoint2D(stream_dots, stream_points);
+		vector<int> tour;
+		for (int i = 0; i < stream_dots.size(); i++){
+			tour.push_back(i);
+		}
+		LinKernighanOptions options;
+		options.time_limit = STREAMING_SLICE;
+		path_stream.reset(new BasicStreamingTour<MachineTimeMetric>(stream_points, tour, STREAMING_COMMIT_AHEAD, options, next_plan.machine_time));
+		path_stream->start();
+		streamed_index = -1;
+	}
+
+	// the machine got home before the path: start the painting now
+	if (homing_done && path_ready){
+		send_current_command(current_command_index);
 	}
 }
 
@@ -194,9 +278,41 @@ void ofApp::init_serial_devices(ofxIO::SLIPPacketSerialDevice &cnc){
     else ofLogNotice("ofApp::setup") << "No devices connected.";
 }
 
+//--------------------------------------------------------------
+// takes the next dot from the stream: the dots already sent stay in sorted_dots,
+// the rest of sorted_dots becomes the latest path of the stream. A dot sent again
+// (a second "home", a retry) is already in sorted_dots[i]: the stream isn't asked again
+//--------------------------------------------------------------
+void ofApp::pull_streamed_dot(int i){
+
+	if (i <= streamed_index){
+		return;
+	}
+
+	int next_dot = path_stream->next();
+	if (next_dot == -1){
+		return;
+	}
+	streamed_index = i;
+
+	vector<int> rest;
+	path_stream->getTour(rest);
+
+	sorted_dots.resize(i);
+	sorted_dots.push_back(stream_dots.at(next_dot));
+	for (auto d : rest){
+		sorted_dots.push_back(stream_dots.at(d));
+	}
+}
+
 //--------------------------------------------------------------
 void ofApp::send_current_command(int i){
 
+	// with the streaming path the dot i is decided now
+	if (path_stream){
+		pull_streamed_dot(i);
+	}
+
     glm::mediump_ivec2 pos = sorted_dots.at(i);
 	// map the position from pixels to mm
     glm::mediump_ivec2 mapped_pos(
@@ -219,31 +335,32 @@ void ofApp::send_current_command(int i){
 //--------------------------------------------------------------
 // OPENCV
 //--------------------------------------------------------------
-// run the coherent line algorithm on a given image
+// run the coherent line algorithm on a given image, sample the dots and plan their path
+// it runs on the worker thread: no OpenGL here (publish_portrait() draws the dots)
 // @args:	in			--> the input image
-// @args:	out			--> the output image (b & w) obtained from CLD
-// @args:	dots_fbo	--> an fbo on top of which we will draw the dots
+// @args:	plan		--> receives the output image (b & w) obtained from CLD, the dots and their path
+// @args:	center		--> the center of the window, the dots are sampled around it
 //--------------------------------------------------------------
-void ofApp::run_coherent_line_drawing(const ofImage &in, ofImage &out, ofFbo &dots_fbo){
+void ofApp::run_coherent_line_drawing(const ofPixels &in, PortraitPlan &plan, glm::vec2 center){
 	
 	// Reset vector
+	vector<glm::mediump_ivec2> & dots = plan.dots;
+	vector<glm::mediump_ivec2> & sorted_dots = plan.sorted_dots;
 	dots.clear();
 	sorted_dots.clear();
 
 	// Do the coherent line drawing magic
-	ofxCv::CLD(input_image, output_image, halfw, smooth_passes, sigma1, sigma2, tau, black);
-	ofxCv::invert(output_image);
-	ofxCv::threshold(output_image, threshold);
-	output_image.update();
+	ofPixels & output_pixels = plan.output_pixels;
+	ofxCv::CLD(in, output_pixels, halfw, smooth_passes, sigma1, sigma2, tau, black);
+	ofxCv::invert(output_pixels);
+	ofxCv::threshold(output_pixels, threshold);
 	
 	// create_debugging_quad(dots, dots_fbo);
 
-	// Draw the dots on their fbo
+	// Sample the dots (publish_portrait() draws them on their fbo)
 	ofLogNotice() << "circle size: " << circle_size;
 	int sampling_size = circle_size;
 
-	dots_fbo.begin();
-
 	int max_dots = 300;
 	int ending_point_x = face_tracking_rectangle.x + face_tracking_rectangle.width;
 	int ending_point_y = face_tracking_rectangle.y + face_tracking_rectangle.height;
@@ -264,12 +381,10 @@ void ofApp::run_coherent_line_drawing(const ofImage &in, ofImage &out, ofFbo &do
 
 			if (dots.size() < max_dots){
 				// if (ofDist(x, y, tracked_face_position.x, tracked_face_position.y) < INTEREST_RADIUS){
-				if (ofDist(x, y, ofGetWidth()/2, ofGetHeight()/2) < INTEREST_RADIUS){
-					ofColor c = output_image.getColor(x, y);
+				if (ofDist(x, y, center.x, center.y) < INTEREST_RADIUS){
+					ofColor c = output_pixels.getColor(x, y);
 
 					if (c.r == 255){
-						ofSetColor(ofColor::orange);
-						ofDrawCircle((int) x, (int) y, circle_size/2);
 						// ofDrawRectangle(x, y, circle_size, circle_size);
 						dots.push_back(glm::mediump_ivec2(x, y));
 					}
@@ -281,16 +396,16 @@ void ofApp::run_coherent_line_drawing(const ofImage &in, ofImage &out, ofFbo &do
 		}
 	}
 
-	dots_fbo.end();	
-
-	// Optimize the path using nearest neighbour
+	// Optimize the path: nearest neighbour (or one of the faster constructions, the dots are on a lattice of sampling_size)
+	// then Lin-Kernighan moves until the deadline, so the path is ready in PATH_DEADLINE seconds whatever the amount of dots
+	// the solver minimizes the time of the machine (X then Y, then the shot), so its cost is already the estimated time
 	ofLogNotice("run_coherent_line_drawing()") << "optimizing path";
-	int overall_path_length = solve_nn(dots, sorted_dots);
-	ofLogNotice("run_coherent_line_drawing") << "overall length of the portrait: " << overall_path_length / 1000 << "m";
-	int estimated_seconds = (overall_path_length * STEPS_PER_MM * SECONDS_BETWEEN_STEPS * MAGIC_NUMBER);
+	plan.machine_time = machine_time_metric(face_tracking_rectangle);
+	BasicLinKernighanSolver<MachineTimeMetric> path_solver(LinKernighanOptions(), PATH_CONSTRUCTION, sampling_size, plan.machine_time);
+	int estimated_seconds = solve_path(dots, sorted_dots, path_solver, PATH_DEADLINE);
 	int estimated_minutes = estimated_seconds / 60;
-	estimated_elapsed_time = ofToString(estimated_minutes) + ":" + ofToString(estimated_seconds % 60);
-	ofLogNotice("run_coherent_line_drawing") << "estimated time (m:s) --> " << estimated_elapsed_time;
+	plan.estimated_elapsed_time = ofToString(estimated_minutes) + ":" + ofToString(estimated_seconds % 60);
+	ofLogNotice("run_coherent_line_drawing") << "estimated time (m:s) --> " << plan.estimated_elapsed_time;
 
 	// for debug, save the points to a csv file
 	ofFile sorted_dots_file("sorted_dots.csv", ofFile::WriteOnly);
@@ -356,51 +471,120 @@ void ofApp::create_debugging_quad(vector<glm::mediump_ivec2> & dots, ofFbo & dot
 //--------------------------------------------------------------
 int ofApp::solve_nn(const vector<glm::mediump_ivec2> & in_points, vector<glm::mediump_ivec2> & out_points){
 
-    // 1. Start on an arbitrary vertex as current vertex
-    int closest_p_index = 0;
-	float nn_distance = 0.0f;
+    // 1. Start on the first vertex as current vertex
+    // 2. go to the nearest unvisited vertex, until every vertex is visited
+    // the unvisited points are kept in a grid, so each step only looks at the points around the current one
+    // duplicate points are kept, they are visited one after the other
+	return nearestNeighbourPath(in_points, out_points);
+}
 
-    // continue while there are still points to visit
-    while (out_points.size() < in_points.size()-1){
+//--------------------------------------------------------------
+// plan the path with any solver of solver.h (nearest neighbour, genetic algorithm, lin-kernighan)
+// it returns by the deadline with the best path found so far
+// @args: 	in_points  --> the points used to compute the path
+// 	  		out_points --> a vector that will be filled with the sorted points
+// 	  		solver     --> the engine
+// 	  		seconds    --> time to plan the path
+//--------------------------------------------------------------
+int ofApp::solve_path(const vector<glm::mediump_ivec2> & in_points, vector<glm::mediump_ivec2> & out_points, Solver & solver, double seconds){
 
-        glm::mediump_ivec2 p = in_points.at(closest_p_index);
+    if (in_points.empty()){
+        return 0;
+    }
 
-        // ofLogNotice() << " out_points: " << out_points.size() << ", in_points: " << in_points.size();
+    Deadline deadline = deadlineIn(seconds);
 
-        float min_distance = MAXFLOAT;
+    vector<Point2D> path_points;
+    toPoint2D(in_points, path_points);
 
-        for (int j = 0; j < in_points.size(); j++){
+    // every path starts from the first dot
+    BestTour best;
+    solver.solve(path_points, 0, deadline, best);
 
-            glm::mediump_ivec2 other_p = in_points.at(j);
+    vector<int> tour;
+    best.get(tour);
+    appendTour(in_points, tour, out_points);
+    ofLogNotice("solve_path") << best.getVersion() << " paths found, " << seconds - secondsLeft(deadline) << " seconds.";
 
-            // check if we already have visited the other p, if so, just skip it
-			// NB using this technique, duplicate points will be removed.
-            if(std::find(out_points.begin(), out_points.end(), other_p) == out_points.end()) {
-                
-                // 2. Find out the shortest edge connecting current vertex and an unvisited vertex V
-                float current_distance = ofDist(p.x, p.y, other_p.x, other_p.y);
-                if (current_distance < min_distance && current_distance > 0){
+    return best.getLength();
+}
 
-                    min_distance = current_distance;
-                    // 3. make this point the next point
-                    closest_p_index = j;
-					// but don't add it to the list until we've checked all the points against the first!
-                }
-            }
-        }
-		// now we can add it to the list of added points:
-		glm::mediump_ivec2 other_p = in_points.at(closest_p_index);
-		out_points.push_back(other_p);
-    }
+//--------------------------------------------------------------
+// the firmware moves X to the end, then Y, then waits SECONDS_PER_DOT and shoots:
+// the dots are mapped from area to the machine like in send_current_command,
+// each step of the motors takes SECONDS_BETWEEN_STEPS (MAGIC_NUMBER is the calibration of the estimate)
+//--------------------------------------------------------------
+MachineTimeMetric ofApp::machine_time_metric(const ofRectangle & area) const{
 
-	// compute distance of nn
-    for (int i = 0; i < out_points.size()-1; i++){
-        auto p = out_points.at(i);
-        auto next_p = out_points.at(i+1);
-        nn_distance += ofDist(p.x, p.y, next_p.x, next_p.y);
-    }
+    double seconds_per_mm = STEPS_PER_MM * SECONDS_BETWEEN_STEPS * MAGIC_NUMBER;
+    double mm_per_pixel_x = (area.width > 0) ? (MACHINE_X_MAX_POS - MACHINE_X_MIN_POS) / area.width : 1;
+    double mm_per_pixel_y = (area.height > 0) ? (MACHINE_Y_MAX_POS - MACHINE_Y_MIN_POS) / area.height : 1;
+    return MachineTimeMetric(mm_per_pixel_x * X_DISTORTION_CORRECTION * seconds_per_mm, mm_per_pixel_y * seconds_per_mm, SECONDS_PER_DOT);
+}
 
-	return nn_distance;
+//--------------------------------------------------------------
+// build a path with one of the constructions of construction.h
+// they only sort the points (Hilbert curve, serpentine rows) or match the nearest points (greedy edges),
+// so they take milliseconds even with many dots, improve_path shortens them
+// @args: 	in_points    --> the points used to compute the path
+// 	  		out_points   --> a vector that will be filled with the sorted points
+// 	  		method       --> NEAREST_NEIGHBOUR, HILBERT_CURVE, SERPENTINE or GREEDY_EDGE
+// 	  		lattice_step --> the distance between two rows of dots (serpentine rows)
+//--------------------------------------------------------------
+int ofApp::solve_construction(const vector<glm::mediump_ivec2> & in_points, vector<glm::mediump_ivec2> & out_points, int method, int lattice_step){
+
+	if (method == NEAREST_NEIGHBOUR){
+		return solve_nn(in_points, out_points);
+	}
+
+    vector<Point2D> path_points;
+    toPoint2D(in_points, path_points);
+
+    // every path starts from the first dot
+    vector<int> tour;
+    constructTour(method, path_points, 0, tour, lattice_step);
+    appendTour(in_points, tour, out_points);
+
+	return pathLength(path_points, tour, false, EuclideanMetric());
+}
+
+//--------------------------------------------------------------
+// improve a path with 2-opt moves: two edges that cross each other (or a long detour)
+// are replaced by two shorter edges, and with Or-opt moves: a segment of up to 3 dots
+// is moved where it costs less, until no move makes the path shorter.
+// the first dot stays the first one and the path doesn't go back to it.
+// @args: 	path       --> the sorted points, they will be sorted again
+// 			time_limit --> seconds, the best path found so far is kept when it's over
+//--------------------------------------------------------------
+int ofApp::improve_path(vector<glm::mediump_ivec2> & path, double time_limit){
+
+	if (path.empty()) return 0;
+
+	vector<Point2D> path_points;
+	toPoint2D(path, path_points);
+	vector<int> tour;
+	tour.reserve(path.size());
+	for (int i = 0; i < path.size(); i++){
+		tour.push_back(i);
+	}
+
+	// only the 8 nearest dots of each dot are tried, so it's fast for thousands of dots
+	LocalSearchOptions options;
+	options.neighbours = 8;
+	options.closed_tour = false;
+	options.time_limit = time_limit;
+	LocalSearch local_search(path_points, options);
+	LocalSearchReport report = local_search.or2Opt(tour);
+
+	ofLogNotice("improve_path") << "length: " << report.initial_length << " --> " << report.final_length
+		<< " (-" << report.improvement() << ", " << report.two_opt_moves << " 2-opt and " << report.or_opt_moves << " Or-opt moves in "
+		<< report.seconds << " seconds" << (report.timed_out ? ", out of time)" : ")");
+
+	vector<glm::mediump_ivec2> improved_path;
+	appendTour(path, tour, improved_path);
+	path.swap(improved_path);
+
+	return report.final_length;
 }
 
 //--------------------------------------------------------------
@@ -488,6 +672,18 @@ void ofApp::onSerialBuffer(const ofx::IO::SerialBufferEventArgs &args){
 		
 		ofLogNotice("onSerialBuffer") << "homing done, starting";
 
+		// the worker is still planning the path: publish_portrait() will start the painting
+		if (!path_ready){
+			// the portrait was dropped (no dots): nothing waits for the machine
+			if (!planning){
+				ofLogNotice("onSerialBuffer") << "no portrait to paint";
+				return;
+			}
+			ofLogNotice("onSerialBuffer") << "waiting for the path";
+			homing_done = true;
+			return;
+		}
+
 		// FIXME: TODO: every 50 shots reset the home
 		// if (current_command_index % 20 == 19){
 		// 	ofLogNotice() << "sending home";
@@ -549,6 +745,11 @@ void ofApp::onSerialBuffer(const ofx::IO::SerialBufferEventArgs &args){
 			ofLogNotice() << "estimated time:    " << estimated_elapsed_time;
 			ofLogNotice() << "real elapsed time: " << real_elapsed_time;
 
+			if (path_stream){
+				ofLogNotice() << "streaming: " << path_stream->getImprovements() << " improvements in " << path_stream->getSlices() << " slices";
+				path_stream.reset();
+			}
+
 			std::exit(0);
 		}
 	}
@@ -571,6 +772,10 @@ void ofApp::onSerialError(const ofx::IO::SerialBufferErrorEventArgs &args){
 // EXIT
 //--------------------------------------------------------------
 void ofApp::exit(){
+	if (plan_worker.joinable()){
+		plan_worker.join();
+	}
+	path_stream.reset();
 	ofSaveScreen("current_portrait.png");
 	cnc_device.unregisterAllEvents(this);
 	// cam_servo_device.unregisterAllEvents(this);
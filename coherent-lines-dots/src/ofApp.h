@@ -8,7 +8,15 @@
 #include "ofxOsc.h"
 #include "ofxFaceTracker.h"
 #include <chrono>
+#include <thread>
+#include <atomic>
 #include "tsp.h" // for solving tsp using a genetic algorithm, thanks to: https://github.com/marcoscastro/tsp_genetic
+#include "construction.h" // nearest neighbour and faster constructions of the paths
+#include "tour_points.h" // the engines on the glm::mediump_ivec2 dots
+#include "local_search.h" // 2-opt and Or-opt improvement of the paths
+#include "solver.h" // engines that plan the paths by a deadline
+#include "streaming.h" // improves the rest of the path while the machine paints
+#include "metric.h" // the paths minimize the time of the machine, not their length
 #include <map>
 
 class ofApp : public ofBaseApp{
@@ -44,9 +52,54 @@ public:
 	// int solve_tsp_with_ga(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points);
 	// Nearest Neighbour approach for finding best path
 	int solve_nn(const vector<glm::mediump_ivec2> & in_points, vector<glm::mediump_ivec2> & out_points);
+	// faster constructions of the path (Hilbert curve, serpentine rows, greedy edges) or nearest neighbour
+	int solve_construction(const vector<glm::mediump_ivec2> & in_points, vector<glm::mediump_ivec2> & out_points, int method, int lattice_step);
+	const int NEAREST_NEIGHBOUR = NEAREST_NEIGHBOUR_TOUR;
+	const int HILBERT_CURVE = HILBERT_TOUR;
+	const int SERPENTINE = SERPENTINE_TOUR;
+	const int GREEDY_EDGE = GREEDY_TOUR;
+	const int PATH_CONSTRUCTION = NEAREST_NEIGHBOUR; // the first path of the solver
+	// plans the path with a solver (an engine of solver.h) and returns by the deadline, returns its cost (length, or seconds with machine_time_metric)
+	int solve_path(const vector<glm::mediump_ivec2> & in_points, vector<glm::mediump_ivec2> & out_points, Solver & solver, double seconds);
+	const double PATH_DEADLINE = 0.5; // seconds to plan the path
+	// seconds of the machine between two dots of the camera inside area (the metric of the paths)
+	MachineTimeMetric machine_time_metric(const ofRectangle & area) const;
+	// removes the crossings and the detours of a path (2-opt and Or-opt), returns the new length
+	int improve_path(vector<glm::mediump_ivec2> & path, double time_limit);
+
+	// PORTRAIT PLANNING
+	// the coherent line drawing, the dots and their path are computed on a worker thread,
+	// so the camera and the rendering don't stop while the machine goes home.
+	// the worker fills next_plan, then update() swaps it with the dots shown by draw() (double buffer)
+	struct PortraitPlan
+	{
+		vector<glm::mediump_ivec2> dots, sorted_dots; // the dots and their path
+		ofPixels output_pixels; // the coherent line drawing
+		string estimated_elapsed_time;
+		MachineTimeMetric machine_time; // metric of the path
+	};
+	PortraitPlan next_plan; // only the worker uses it while planning
+	std::thread plan_worker;
+	std::atomic<bool> plan_ready; // true when the worker has finished next_plan
+	bool planning; // true while the worker runs
+	bool path_ready; // true when sorted_dots holds the path of the portrait
+	bool homing_done; // true if the machine is at home and waits for the path
+	void start_portrait(); // starts the worker on the current camera image
+	void publish_portrait(); // takes the plan of the worker (main thread)
+
+	// STREAMING
+	// the machine takes about 5 seconds for each dot: it starts from the planned path
+	// while a worker thread keeps improving the dots it hasn't reached yet
+	const bool STREAMING_PATH = true;
+	const int STREAMING_COMMIT_AHEAD = 3; // dots that can't change anymore ahead of the machine
+	const double STREAMING_SLICE = 0.25; // seconds of each improvement of the rest of the path
+	std::unique_ptr<BasicStreamingTour<MachineTimeMetric>> path_stream;
+	vector<glm::mediump_ivec2> stream_dots; // the dots of path_stream (it works on their indexes)
+	int streamed_index; // the last index of sorted_dots taken from path_stream (-1 before the first)
+	void pull_streamed_dot(int i); // puts the next dot of the stream in sorted_dots[i], and the rest of the path after it (once for each i)
 
 	// OPENCV
-	void run_coherent_line_drawing(const ofImage &in, ofImage &out, ofFbo &dots_fbo);
+	void run_coherent_line_drawing(const ofPixels &in, PortraitPlan &plan, glm::vec2 center);
 	void create_debugging_quad(vector<glm::mediump_ivec2> & dots, ofFbo & dots_fbo);
 
 	ofImage input_image, output_image;
@@ -70,7 +123,7 @@ public:
 	int current_command_index; // keeps track of the current command that we're sending
 	const int SERIAL_INITIAL_DELAY_TIME = 1; // seconds
 
-	int button_pressed_time;
+	float button_pressed_time;
 	bool draw_dots;
 	
 	// CNC
@@ -84,6 +137,7 @@ public:
 	const double SECONDS_BETWEEN_STEPS = 0.0005;
 	const float MAGIC_NUMBER = 3.442;
 	const float X_DISTORTION_CORRECTION = 1.25;
+	const double SECONDS_PER_DOT = 5.0; // the machine waits on each dot before shooting (delay in on_stepper)
 	string estimated_elapsed_time, real_elapsed_time;
 
 	ofxIO::SLIPPacketSerialDevice cnc_device;
@@ -303,6 +303,10 @@ void ofApp::keyPressed(int key){
             // export_dots_to_csv(darker_dots_positions, "black_dots.csv");
             ofLogNotice() << "button pressed!";
 
+            // the dots keep changing with the camera, the job is planned on the current ones
+            plan_job();
+            current_command_index = 0;
+
             // people pressed the red button, fun is coming!
             // 1. let's start by telling the arduino we're starting
 
@@ -312,16 +316,54 @@ void ofApp::keyPressed(int key){
             * check for arduino response
             * send next message
             */
-            send_current_command(current_command_index);
+            if (!job_commands.empty()){
+                send_current_command(current_command_index);
+            }
         }
     }
     else if (key == 's') show_live_feed = !show_live_feed;
 }
 
 //--------------------------------------------------------------
-void ofApp::send_current_command(int i){
+// JOB
+//--------------------------------------------------------------
+// plan the midtones and the darker dots as a single job that minimizes the time of the machine:
+// each color is painted in one go, the planner chooses which one goes first
+// and starts each path near the end of the previous one (the machine starts from 0, 0)
+//--------------------------------------------------------------
+void ofApp::plan_job(){
+
+    const vector<glm::vec2> * colors[] = {&midtones_dots_positions, &darker_dots_positions};
+    const std::string pick_commands[] = {PICK_MIDTONES_COMMAND, PICK_DARKER_COMMAND};
 
-    auto pos = midtones_dots_positions.at(i);
+    vector<vector<Point2D>> layers(2);
+    for (int l = 0; l < 2; l++){
+        toPoint2D(*colors[l], layers[l]);
+    }
+
+    // the machine moves X and then Y, the change of color costs the same unit (seconds)
+    ColorPlanOptions options;
+    options.switch_cost = COLOR_SWITCH_SECONDS;
+    options.time_limit = JOB_PLANNING_TIME;
+    MachineTimeMetric machine_time(SECONDS_PER_PIXEL, SECONDS_PER_PIXEL, 0);
+    ColorPlan plan;
+    planColorLayers(layers, {0, 0}, plan, options, machine_time);
+
+    job_commands.clear();
+    for (int i = 0; i < plan.order.size(); i++){
+        int color = plan.order.at(i);
+        job_commands.push_back(pick_commands[color]);
+        for (auto d : plan.paths.at(i)){
+            job_commands.push_back(move_command(colors[color]->at(d)));
+        }
+    }
+
+    ofLogNotice("plan_job") << midtones_dots_positions.size() << " midtones, " << darker_dots_positions.size() << " darker dots, "
+                            << plan.order.size() << " colors, estimated time: " << plan.cost << " seconds";
+}
+
+//--------------------------------------------------------------
+std::string ofApp::move_command(glm::vec2 pos){
 
     // Create a byte buffer.
     // ofx::IO::ByteBuffer buffer('M' + ofToString(pos.x) + ',' + ofToString(pos.y));
@@ -331,9 +373,15 @@ void ofApp::send_current_command(int i){
     ss << "MX" << std::setw(3) << std::setfill('0') << pos.x;
     ss << "Y" << std::setfill('0') << pos.y;
 
-    sent_command = ss.str();
+    return ss.str();
+}
+
+//--------------------------------------------------------------
+void ofApp::send_current_command(int i){
 
-    ofLogNotice() << "sending " << sent_command << ", " << current_command_index+1 << "/" << ofToString(midtones_dots_positions.size());
+    sent_command = job_commands.at(i);
+
+    ofLogNotice() << "sending " << sent_command << ", " << current_command_index+1 << "/" << ofToString(job_commands.size());
 
     ofx::IO::ByteBuffer buffer(sent_command);
 
@@ -367,14 +415,14 @@ void ofApp::onSerialBuffer(const ofx::IO::SerialBufferEventArgs& args){
     // check if the received message is the one we sent
     // if yes, then send the next message
     
-    if (current_command_index <= midtones_dots_positions.size() - 1){
-        if (sent_command == received_command){
+    if (sent_command == received_command){
+        if (current_command_index + 1 < job_commands.size()){
             send_current_command(++current_command_index);
         }
-    }
-    else {
-        ofLogNotice() << "sent all commands!";
-        current_command_index = 0;
+        else {
+            ofLogNotice() << "sent all commands!";
+            current_command_index = 0;
+        }
     }
 }
 
@@ -7,6 +7,8 @@
 #include "ofxSerial.h"
 #include "ofxFaceTracker.h"
 #include "ofEvents.h"
+#include "color_plan.h" // orders the dots of both colors into a single job
+#include "tour_points.h" // the engines on glm::vec2 points
 
 struct SerialMessage{
     std::string message;
@@ -63,6 +65,18 @@ class ofApp : public ofBaseApp{
 		vector<glm::vec2> midtones_dots_positions; 
 		vector<glm::vec2> darker_dots_positions;
 
+		// JOB
+		// the dots of both colors in one job: each color is a path of its own,
+		// the planner chooses the first color and where each path starts
+		void plan_job(); // fills job_commands with the dots of the current frame
+		std::string move_command(glm::vec2 pos); // the command that moves the machine to a dot
+		vector<std::string> job_commands; // a pick command at each change of color, then the moves of its dots
+		const std::string PICK_MIDTONES_COMMAND = "PR"; // red balls for the midtones
+		const std::string PICK_DARKER_COMMAND = "PB"; // blue balls for the darker dots
+		const double SECONDS_PER_PIXEL = 0.0086; // time of the machine for a pixel of the camera (on each axis)
+		const double COLOR_SWITCH_SECONDS = 10; // time to pick the balls of the other color
+		const double JOB_PLANNING_TIME = 0.5; // seconds to plan the paths of the job
+
 		// SERIAL
 		// serial communication with arduino
 		const int BAUD_RATE = 115200;
@@ -11,6 +11,8 @@ void ofApp::setup(){
     default_distance = 0;
     nn_distance = 0;
     ga_tsp_distance = 0;
+    improved_distance = 0;
+    lk_distance = 0;
     
     load_points_from_csv(points, "dots.csv");
 
@@ -42,14 +44,22 @@ void ofApp::setup(){
         nn_distance += ofDist(p.x, p.y, next_p.x, next_p.y);
     }
 
+    // 1b. the nearest neighbour path without its crossings and detours (2-opt and Or-opt)
+    improved_distance = improve_path(points_nn_path, points_improved_path);
+
     glPointSize(4);
 
     // 2. SMARTER (but not so efficient) ATTEMPT --> TSP using genetic algorithms
     ga_tsp_distance = solve_tsp(points, points_ga_tsp_path);
 
+    // 3. Lin-Kernighan style local search, same input as the genetic algorithm
+    lk_distance = solve_lk(points, points_lk_path);
+
     ofLogNotice() << "default distance: " << default_distance;
     ofLogNotice() << "nn distance:      " << nn_distance;
     ofLogNotice() << "ga tsp distance:  " << ga_tsp_distance;
+    ofLogNotice() << "nn improved distance: " << improved_distance;
+    ofLogNotice() << "lk distance:      " << lk_distance;
 }
 
 //--------------------------------------------------------------
@@ -97,6 +107,24 @@ void ofApp::draw(){
             ofDrawLine(p.x, p.y, next_p.x, next_p.y);
         }    
     }
+    else if (current_algorithm_view == NN_IMPROVED){
+        ofDrawBitmapStringHighlight("nearest neighbour + 2-opt + or-opt", 20, 20);
+        ofDrawBitmapStringHighlight("distance: " + ofToString(improved_distance), 20, 35);
+        for (int i = 0; i < points_improved_path.size()-1; i++){
+            auto p = points_improved_path.at(i);
+            auto next_p = points_improved_path.at(i+1);
+            ofDrawLine(p.x, p.y, next_p.x, next_p.y);
+        }
+    }
+    else if (current_algorithm_view == LIN_KERNIGHAN){
+        ofDrawBitmapStringHighlight("lin-kernighan", 20, 20);
+        ofDrawBitmapStringHighlight("distance: " + ofToString(lk_distance), 20, 35);
+        for (int i = 0; i < points_lk_path.size()-1; i++){
+            auto p = points_lk_path.at(i);
+            auto next_p = points_lk_path.at(i+1);
+            ofDrawLine(p.x, p.y, next_p.x, next_p.y);
+        }
+    }
 }
 
 //--------------------------------------------------------------
@@ -114,6 +142,14 @@ void ofApp::keyPressed(int key){
             current_algorithm_view = TSP_GENETIC;
             break;
         }
+        case '4':{
+            current_algorithm_view = NN_IMPROVED;
+            break;
+        }
+        case '5':{
+            current_algorithm_view = LIN_KERNIGHAN;
+            break;
+        }
     }
 }
 
@@ -151,42 +187,28 @@ void ofApp::load_points_from_csv(vector<glm::vec2> & vec, std::string path){
 }
 
 //--------------------------------------------------------------
-int ofApp::solve_tsp(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points){    //srand(time(NULL)); // random numbers
+int ofApp::solve_tsp(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points){
 	
-	// creates the graph1 with parameters: number of vertexes and initial vertex
-	Graph * graph = new Graph(in_points.size(), 0);
-
-    // for each point compute the distance to every other point
-    for (int i = 0; i < in_points.size(); i++){
-        auto p = in_points.at(i);
-        
-        for (int j = 0; j < in_points.size(); j++){
-            
-            if (i != j){
-                auto next_p = in_points.at(j);
-                int cost = round(ofDist(p.x, p.y, next_p.x, next_p.y));
-                graph->addEdge(i, j, cost);
-            }
-        }
-    }
+	// creates a geometric graph with parameters: the points and initial vertex
+	// the cost of each edge is computed from the points only when the GA needs it,
+	// so there's no V * V matrix to fill before starting
+    vector<Point2D> graph_points;
+    toPoint2D(in_points, graph_points);
+	Graph * graph = new Graph(graph_points, 0);
 	
-	// parameters: the graph, population size, generations and mutation rate
-	// optional parameters: show_population
-	Genetic genetic(graph, 20, 10000, 30, false);
-
-	const clock_t begin_time = clock(); // gets time
+	// parameters: the graph, islands, threads, population size, generations, mutation rate and
+	// generations between two migrations of the best solutions
+	// optional parameters: topology and seed
+	// every island is a population of the genetic algorithm running on its own thread
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	GeneticIslands genetic(graph, threads, threads, 20, 10000, 30, 500, GeneticIslands::RING, 0);
+
+	const float begin_time = ofGetElapsedTimef(); // gets time (wall clock, the islands run in parallel)
 	genetic.run(); // runs the genetic algorithm
-	ofLogNotice() << "Genetic algorithm, elapsed time: " << float(clock () - begin_time) /  CLOCKS_PER_SEC << " seconds."; // shows time in seconds
+	ofLogNotice() << "Genetic algorithm (" << threads << " islands), elapsed time: " << ofGetElapsedTimef() - begin_time << " seconds."; // shows time in seconds
     
     // add the resulting points
-    const vector<int>& points_vec = genetic.population[0].first;
-	for(int i = 0; i < graph->V; i++){
-
-        //ofLogNotice() << "point at " << i << ": " << points_vec.at(i);
-
-        glm::vec2 p = in_points.at(points_vec.at(i));
-        out_points.push_back(p);
-    }
+    appendTour(in_points, genetic.getBestSolution(), out_points);
 
     // free memory
     delete graph;
@@ -196,43 +218,60 @@ int ofApp::solve_tsp(const vector<glm::vec2> & in_points, vector<glm::vec2> & ou
 }
 
 //--------------------------------------------------------------
-void ofApp::solve_nn(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points){
+int ofApp::solve_lk(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points){
 
-    // 1. Start on an arbitrary vertex as current vertex
-    int closest_p_index = 0;
+    // the path starts from the first point (like the genetic algorithm) and doesn't go back to it
+    vector<Point2D> lk_points;
+    toPoint2D(in_points, lk_points);
+    vector<int> tour;
+    for (int i = 0; i < in_points.size(); i++){
+        tour.push_back(i);
+    }
 
-    glm::vec2 p = in_points.at(closest_p_index);
+    // candidates: the 8 nearest points of each point, kicks until 1 second
+    LinKernighanOptions options;
+    options.neighbours = 8;
+    options.closed_tour = false;
+    options.time_limit = 1.0;
+    LinKernighan lin_kernighan(lk_points, options);
+    LocalSearchReport report = lin_kernighan.solve(tour);
+    ofLogNotice() << "Lin-Kernighan: " << report.lk_moves << " chains, " << report.kicks << " kicks, elapsed time: " << report.seconds << " seconds.";
 
-    // continue while there are still points to visit
-    while (out_points.size() < in_points.size()-1){
+    appendTour(in_points, tour, out_points);
 
-        glm::vec2 p = points.at(closest_p_index);
+    return report.final_length;
+}
 
-        ofLogNotice() << " out_points: " << out_points.size() << ", in_points: " << in_points.size();
+//--------------------------------------------------------------
+float ofApp::improve_path(const vector<glm::vec2> & in_path, vector<glm::vec2> & out_path){
+
+    // the path starts from the first point and doesn't go back to it
+    vector<Point2D> path_points;
+    toPoint2D(in_path, path_points);
+    vector<int> tour;
+    for (int i = 0; i < in_path.size(); i++){
+        tour.push_back(i);
+    }
 
-        float min_distance = MAXFLOAT;
+    // candidates: the 8 nearest points of each point
+    LocalSearchOptions options;
+    options.neighbours = 8;
+    options.closed_tour = false;
+    LocalSearch local_search(path_points, options);
+    LocalSearchReport report = local_search.or2Opt(tour);
+    ofLogNotice() << "2-opt: " << report.two_opt_moves << " moves, Or-opt: " << report.or_opt_moves << " moves, elapsed time: " << report.seconds << " seconds.";
 
-        for (int j = 0; j < in_points.size(); j++){
+    appendTour(in_path, tour, out_path);
 
-            glm::vec2 other_p = in_points.at(j);
+    return report.final_length;
+}
 
-            // check if we already have visited the other p, if so, just skip it
-			// NB using this technique, duplicate points will be removed.
-            if(std::find(out_points.begin(), out_points.end(), other_p) == out_points.end()) {
-                
-                // 2. Find out the shortest edge connecting current vertex and an unvisited vertex V
-                float current_distance = ofDist(p.x, p.y, other_p.x, other_p.y);
-                if (current_distance < min_distance && current_distance > 0){
+//--------------------------------------------------------------
+void ofApp::solve_nn(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points){
 
-                    min_distance = current_distance;
-                    // 3. make this point the next point
-                    closest_p_index = j;
-					// but don't add it to the list until we've checked all the points against the first!
-                }
-            }
-        }
-		// now we can add it to the list of added points:
-		glm::vec2 other_p = in_points.at(closest_p_index);
-		out_points.push_back(other_p);
-    }
+    // 1. Start on the first vertex as current vertex
+    // 2. go to the nearest unvisited vertex, until every vertex is visited
+    // the unvisited points are kept in a grid, so each step only looks at the points around the current one
+    // duplicate points are kept, they are visited one after the other
+    nearestNeighbourPath(in_points, out_points);
 }
\ No newline at end of file
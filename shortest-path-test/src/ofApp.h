@@ -2,6 +2,9 @@
 
 #include "ofMain.h"
 #include "tsp.h" // for solving tsp using a genetic algorithm, source: https://github.com/marcoscastro/tsp_genetic
+#include "tour_points.h" // the engines on glm::vec2 points
+#include "local_search.h" // 2-opt and Or-opt improvement of a path
+#include "lin_kernighan.h" // Lin-Kernighan style solver
 
 class ofApp : public ofBaseApp{
 
@@ -15,6 +18,8 @@ class ofApp : public ofBaseApp{
 		vector<glm::vec2> points;
 		vector<glm::vec2> points_nn_path;
 		vector<glm::vec2> points_ga_tsp_path;
+		vector<glm::vec2> points_improved_path;
+		vector<glm::vec2> points_lk_path;
 
 		// Mesh used to draw the points
 		ofMesh mesh;
@@ -24,16 +29,26 @@ class ofApp : public ofBaseApp{
 		const int DEFAULT = 0;
 		const int NEAREST_NEIGHBOUR = 1;
 		const int TSP_GENETIC = 2;
+		const int NN_IMPROVED = 3;
+		const int LIN_KERNIGHAN = 4;
 
 		 // for measuring the overall length of the different approaches
 		float nn_distance;
 		float default_distance;
 		float ga_tsp_distance;
+		float improved_distance;
+		float lk_distance;
 		void load_points_from_csv(vector<glm::vec2> & vec, std::string path);
 
 		// TSP genetic algorithm approach using external library
 		int solve_tsp(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points);
 
+		// Lin-Kernighan style approach (variable depth moves and kicks for 1 second)
+		int solve_lk(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points);
+
 		// Nearest Neighbour approach for finding best path
 		void solve_nn(const vector<glm::vec2> & in_points, vector<glm::vec2> & out_points);
+
+		// 2-opt and Or-opt improvement of a path made by another approach
+		float improve_path(const vector<glm::vec2> & in_path, vector<glm::vec2> & out_path);
 };
@@ -0,0 +1,262 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "tsp.h" // Random, Point2D
+using namespace std;
+
+
+/*
+	Generates dot sets like the ones of the apps, for the scaling tests: one "x,y" line
+	for each dot (integer coordinates), the format of dots.csv and load_points_from_csv.
+
+	Distributions:
+		uniform    --> anywhere on the canvas
+		clustered  --> gaussian clusters around random centers
+		lattice    --> nodes of a grid of step pixels (sampling_size of the apps) inside
+		               smooth blobs, like the dark areas of a thresholded portrait
+		strokes    --> nodes of the same grid along random curved lines, like the dots
+		               sampled from the lines of the coherent line drawing
+	Without a canvas size, the canvas grows with the dots: there are about two nodes of
+	the grid for each dot, so 1k and 1M dots have the same density.
+*/
+
+
+// parameters of the generator (from the command line)
+struct GeneratorOptions
+{
+	string distribution; // uniform, clustered, lattice or strokes
+	int amount_points; // dots to generate
+	int width, height; // canvas, 0 to size it from the dots
+	int step; // step of the grid of lattice and strokes
+	int clusters; // clusters of clustered, 0 for one every 1000 dots
+	uint64_t seed; // seed of the random numbers
+	string output; // file, empty for the standard output
+	GeneratorOptions() : distribution("uniform"), amount_points(1000), width(0), height(0), step(8), clusters(0), seed(0) {}
+};
+
+
+static void usage()
+{
+	cout << "usage: dot-generator [options]\n"
+		<< "  --distribution d   uniform, clustered, lattice or strokes (default uniform)\n"
+		<< "  --points n         dots to generate (default 1000)\n"
+		<< "  --size w h         canvas in pixels (default: sized from the dots)\n"
+		<< "  --step s           step of the grid of lattice and strokes (default 8)\n"
+		<< "  --clusters c       clusters of clustered (default: one every 1000 dots)\n"
+		<< "  --seed s           seed of the random numbers (default 0)\n"
+		<< "  --output file      output file (default: standard output)\n";
+	exit(1);
+}
+
+
+static GeneratorOptions parseArguments(int argc, char* argv[])
+{
+	GeneratorOptions options;
+	for(int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		bool has_value = (i + 1 < argc);
+
+		if(argument == "--distribution" && has_value)
+			options.distribution = argv[++i];
+		else if(argument == "--points" && has_value)
+			options.amount_points = atoi(argv[++i]);
+		else if(argument == "--size" && i + 2 < argc)
+		{
+			options.width = atoi(argv[++i]);
+			options.height = atoi(argv[++i]);
+		}
+		else if(argument == "--step" && has_value)
+			options.step = atoi(argv[++i]);
+		else if(argument == "--clusters" && has_value)
+			options.clusters = atoi(argv[++i]);
+		else if(argument == "--seed" && has_value)
+			options.seed = strtoull(argv[++i], NULL, 10);
+		else if(argument == "--output" && has_value)
+			options.output = argv[++i];
+		else
+			usage();
+	}
+
+	if(options.amount_points < 1 || options.step < 1 || options.width < 0 || options.height < 0)
+		usage();
+	return options;
+}
+
+
+// random number in [0, 1)
+static double uniformReal(Random& random)
+{
+	return (random.next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+// standard normal random number (Box-Muller)
+static double normal(Random& random)
+{
+	double u = 1.0 - uniformReal(random);
+	double v = uniformReal(random);
+	return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+
+static void uniformDots(const GeneratorOptions& options, Random& random, vector<Point2D>& dots)
+{
+	for(int i = 0; i < options.amount_points; i++)
+		dots.push_back({(float)random.uniform(options.width), (float)random.uniform(options.height)});
+}
+
+
+static void clusteredDots(const GeneratorOptions& options, Random& random, vector<Point2D>& dots)
+{
+	int clusters = (options.clusters > 0) ? options.clusters : options.amount_points / 1000 + 1;
+	double sigma = min(options.width, options.height) / (4.0 * sqrt((double)clusters));
+
+	vector<Point2D> centers;
+	for(int c = 0; c < clusters; c++)
+		centers.push_back({(float)random.uniform(options.width), (float)random.uniform(options.height)});
+
+	for(int i = 0; i < options.amount_points; i++)
+	{
+		const Point2D& center = centers[random.uniform(clusters)];
+		double x = min(max(center.x + sigma * normal(random), 0.0), options.width - 1.0);
+		double y = min(max(center.y + sigma * normal(random), 0.0), options.height - 1.0);
+		dots.push_back({(float)floor(x), (float)floor(y)});
+	}
+}
+
+
+/*
+	The darkest nodes of a smooth tone: the tone is a sum of gaussian blobs with some
+	noise, the dots are the amount_points nodes with the highest tone.
+*/
+static void latticeDots(const GeneratorOptions& options, Random& random, vector<Point2D>& dots)
+{
+	int step = options.step;
+	int columns = options.width / step;
+	int rows = options.height / step;
+
+	int blobs = min(options.amount_points / 2000 + 3, 40); // each node adds up all the blobs
+	vector<Point2D> centers;
+	vector<double> sigmas;
+	for(int b = 0; b < blobs; b++)
+	{
+		centers.push_back({(float)random.uniform(options.width), (float)random.uniform(options.height)});
+		sigmas.push_back(min(options.width, options.height) * (0.05 + 0.2 * uniformReal(random)) / sqrt(blobs / 3.0));
+	}
+
+	vector<pair<double, int> > tones(columns * rows);
+	for(int node = 0; node < columns * rows; node++)
+	{
+		double x = (node % columns) * step + step / 2;
+		double y = (node / columns) * step + step / 2;
+		double tone = 0.3 * uniformReal(random);
+		for(int b = 0; b < blobs; b++)
+		{
+			double dx = x - centers[b].x;
+			double dy = y - centers[b].y;
+			tone += exp(-(dx * dx + dy * dy) / (2 * sigmas[b] * sigmas[b]));
+		}
+		tones[node] = make_pair(-tone, node);
+	}
+
+	nth_element(tones.begin(), tones.begin() + options.amount_points, tones.end());
+	for(int i = 0; i < options.amount_points; i++)
+	{
+		int node = tones[i].second;
+		dots.push_back({(float)((node % columns) * step + step / 2), (float)((node / columns) * step + step / 2)});
+	}
+}
+
+
+/*
+	Lines that turn slowly (a random walk of the direction), sampled every half step:
+	a dot for each node of the grid they cross for the first time.
+*/
+static void strokeDots(const GeneratorOptions& options, Random& random, vector<Point2D>& dots)
+{
+	int step = options.step;
+	int columns = options.width / step;
+	int rows = options.height / step;
+	vector<bool> used(columns * rows, false);
+
+	while((int)dots.size() < options.amount_points)
+	{
+		double x = random.uniform(options.width);
+		double y = random.uniform(options.height);
+		double angle = 2.0 * M_PI * uniformReal(random);
+		int length = 20 + random.uniform(100); // samples of the line
+
+		for(int s = 0; s < length && (int)dots.size() < options.amount_points; s++)
+		{
+			int column = (int)(x / step);
+			int row = (int)(y / step);
+			if(column < 0 || column >= columns || row < 0 || row >= rows)
+				break;
+
+			int node = row * columns + column;
+			if(!used[node])
+			{
+				used[node] = true;
+				dots.push_back({(float)(column * step + step / 2), (float)(row * step + step / 2)});
+			}
+
+			angle += 0.25 * normal(random);
+			x += 0.5 * step * cos(angle);
+			y += 0.5 * step * sin(angle);
+		}
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	GeneratorOptions options = parseArguments(argc, argv);
+
+	// a 4:3 canvas with two nodes of the grid for each dot
+	if(options.width == 0 || options.height == 0)
+	{
+		double area = 2.0 * options.amount_points * options.step * options.step;
+		options.height = (int)ceil(sqrt(area * 3 / 4)) + options.step;
+		options.width = (int)ceil(options.height * 4.0 / 3) + options.step;
+	}
+
+	// the lines need free nodes to cross: half of the grid at most
+	long nodes = (long)(options.width / options.step) * (options.height / options.step);
+	if((options.distribution == "lattice" && nodes < options.amount_points) || (options.distribution == "strokes" && nodes < 2L * options.amount_points))
+	{
+		cout << "Error: the canvas is too small for " << options.amount_points << " dots on a grid of step " << options.step << "\n";
+		exit(1);
+	}
+
+	Random random(options.seed);
+	vector<Point2D> dots;
+	dots.reserve(options.amount_points);
+	if(options.distribution == "uniform")
+		uniformDots(options, random, dots);
+	else if(options.distribution == "clustered")
+		clusteredDots(options, random, dots);
+	else if(options.distribution == "lattice")
+		latticeDots(options, random, dots);
+	else if(options.distribution == "strokes")
+		strokeDots(options, random, dots);
+	else
+		usage();
+
+	FILE* file = options.output.empty() ? stdout : fopen(options.output.c_str(), "w");
+	if(file == NULL)
+	{
+		cout << "Error: can't write " << options.output << "\n";
+		exit(1);
+	}
+	for(size_t i = 0; i < dots.size(); i++)
+		fprintf(file, "%d,%d\n", (int)dots[i].x, (int)dots[i].y);
+	if(file != stdout)
+		fclose(file);
+	return 0;
+}
@@ -0,0 +1,480 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h> // opendir
+#include <unistd.h> // fork, pipe
+#include <sys/wait.h> // wait4
+#include <sys/resource.h> // rusage
+#include "tsp.h"
+#include "construction.h"
+#include "local_search.h"
+#include "lin_kernighan.h"
+#include "solver.h"
+#include "metric.h"
+using namespace std;
+
+
+/*
+	Headless benchmark of the tsp solvers: every solver runs on every point file
+	(one "x,y" line for each point, like the dots.csv of the apps) a few times,
+	each run with its own seed (seed + run), in its own process so that its peak
+	resident memory is its own. The tours start from the first point and are
+	measured as open paths (closed with --closed), like the paths of the machine.
+	The gap is the distance from the best known length of the instance (--best)
+	or else from the shortest tour of the benchmark.
+
+	TSPLIB instances (.tsp files with coordinates, EUC_2D or ATT) are measured as
+	closed tours with the weights of TSPLIB (Graph::tourCost), so their gap can
+	come from the published optimal lengths. With --tours each tour is written as
+	a .tour file, to check it with the tools of TSPLIB.
+*/
+
+
+// parameters of the benchmark (from the command line)
+struct BenchmarkOptions
+{
+	vector<string> solvers; // solvers to run
+	int runs; // runs of each solver on each instance
+	uint64_t seed; // seed of the first run
+	double seconds; // deadline of each run of the anytime solvers (nn+ga, lk)
+	bool closed_tour; // true to measure the tours as closed tours
+	bool json; // JSON instead of CSV
+	string best_file; // best known lengths ("instance,length" lines)
+	string tours_dir; // directory of the .tour files, empty to not write them
+	vector<string> paths; // point files and directories of point files
+	BenchmarkOptions() : runs(3), seed(0), seconds(1.0), closed_tour(false), json(false) {}
+};
+
+
+// a run of a solver on an instance
+struct RunResult
+{
+	string instance; // name of the point file
+	int points; // points of the instance
+	string solver; // name of the solver
+	int run; // run of the solver on the instance
+	uint64_t seed; // seed of the run
+	double length; // length of the tour
+	double gap; // percentage over the best known length
+	double seconds; // wall time of the solver
+	long peak_rss_kb; // peak resident memory of the run (kilobytes)
+	bool valid; // true if the tour is a permutation of the points from the first one
+};
+
+
+// what a run sends from its process
+struct RunOutput
+{
+	double length;
+	double seconds;
+	int valid;
+};
+
+
+static const char* SOLVERS[] = {"default", "nn", "hilbert", "serpentine", "greedy", "nn+or2opt", "nn+ga", "lk"};
+static const int AMOUNT_SOLVERS = sizeof(SOLVERS) / sizeof(SOLVERS[0]);
+
+
+static void usage()
+{
+	cout << "usage: tsp-benchmark [options] <point files or directories>\n"
+		<< "  --solvers a,b,...  solvers to run (default: all of";
+	for(int i = 0; i < AMOUNT_SOLVERS; i++)
+		cout << ' ' << SOLVERS[i];
+	cout << ")\n"
+		<< "  --runs n           runs of each solver on each instance (default 3)\n"
+		<< "  --seed s           seed of the first run, run i uses s + i (default 0)\n"
+		<< "  --seconds t        deadline of nn+ga and lk (default 1)\n"
+		<< "  --closed           measures closed tours instead of open paths\n"
+		<< "  --best file        best known lengths, \"instance,length\" lines\n"
+		<< "  --tours dir        writes the tour of each run as a TSPLIB .tour file in dir\n"
+		<< "  --json             JSON output instead of CSV\n";
+	exit(1);
+}
+
+
+static BenchmarkOptions parseArguments(int argc, char* argv[])
+{
+	BenchmarkOptions options;
+	for(int i = 0; i < AMOUNT_SOLVERS; i++)
+		options.solvers.push_back(SOLVERS[i]);
+
+	for(int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		bool has_value = (i + 1 < argc);
+
+		if(argument == "--solvers" && has_value)
+		{
+			options.solvers.clear();
+			stringstream ss(argv[++i]);
+			string solver;
+			while(getline(ss, solver, ','))
+			{
+				if(find(SOLVERS, SOLVERS + AMOUNT_SOLVERS, solver) == SOLVERS + AMOUNT_SOLVERS)
+				{
+					cout << "Error: unknown solver " << solver << "\n";
+					exit(1);
+				}
+				options.solvers.push_back(solver);
+			}
+		}
+		else if(argument == "--runs" && has_value)
+			options.runs = atoi(argv[++i]);
+		else if(argument == "--seed" && has_value)
+			options.seed = strtoull(argv[++i], NULL, 10);
+		else if(argument == "--seconds" && has_value)
+			options.seconds = atof(argv[++i]);
+		else if(argument == "--best" && has_value)
+			options.best_file = argv[++i];
+		else if(argument == "--tours" && has_value)
+			options.tours_dir = argv[++i];
+		else if(argument == "--closed")
+			options.closed_tour = true;
+		else if(argument == "--json")
+			options.json = true;
+		else if(argument.compare(0, 2, "--") == 0)
+			usage();
+		else
+			options.paths.push_back(argument);
+	}
+
+	if(options.paths.empty() || options.solvers.empty() || options.runs < 1)
+		usage();
+	return options;
+}
+
+
+static bool hasExtension(const string& name, const string& extension)
+{
+	return name.size() > extension.size() && name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+
+// the point files of a path: the path itself or the .csv and .tsp files of a directory (sorted)
+static void findInstances(const string& path, vector<string>& files)
+{
+	DIR* dir = opendir(path.c_str());
+	if(dir == NULL)
+	{
+		files.push_back(path);
+		return;
+	}
+
+	vector<string> names;
+	for(struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir))
+	{
+		string name = entry->d_name;
+		if(hasExtension(name, ".csv") || hasExtension(name, ".tsp"))
+			names.push_back(path + "/" + name);
+	}
+	closedir(dir);
+
+	sort(names.begin(), names.end());
+	files.insert(files.end(), names.begin(), names.end());
+}
+
+
+static string baseName(const string& path)
+{
+	size_t slash = path.find_last_of('/');
+	return (slash == string::npos) ? path : path.substr(slash + 1);
+}
+
+
+// one "x,y" line for each point
+static void loadPoints(const string& path, vector<Point2D>& points)
+{
+	ifstream file(path.c_str());
+	if(!file)
+	{
+		cout << "Error: can't open " << path << "\n";
+		exit(1);
+	}
+
+	points.clear();
+	string line;
+	while(getline(file, line))
+	{
+		size_t comma = line.find(',');
+		if(comma == string::npos)
+			continue;
+		points.push_back({(float)atof(line.c_str()), (float)atof(line.c_str() + comma + 1)});
+	}
+}
+
+
+// "instance,length" lines, # for comments
+static void loadBestLengths(const string& path, map<string, double>& best)
+{
+	ifstream file(path.c_str());
+	if(!file)
+	{
+		cout << "Error: can't open " << path << "\n";
+		exit(1);
+	}
+
+	string line;
+	while(getline(file, line))
+	{
+		size_t comma = line.find(',');
+		if(line.empty() || line[0] == '#' || comma == string::npos)
+			continue;
+		best[line.substr(0, comma)] = atof(line.c_str() + comma + 1);
+	}
+}
+
+
+static bool isValidTour(const vector<int>& tour, int amount_points)
+{
+	if((int)tour.size() != amount_points || tour.empty() || tour[0] != 0)
+		return false;
+
+	vector<bool> visited(amount_points, false);
+	for(size_t i = 0; i < tour.size(); i++)
+	{
+		if(tour[i] < 0 || tour[i] >= amount_points || visited[tour[i]])
+			return false;
+		visited[tour[i]] = true;
+	}
+	return true;
+}
+
+
+// builds the tour of a solver from the first point
+static void runSolver(const string& solver, const vector<Point2D>& points, const BenchmarkOptions& options, uint64_t seed, vector<int>& tour)
+{
+	tour.clear();
+	if(solver == "default")
+	{
+		for(size_t i = 0; i < points.size(); i++)
+			tour.push_back(i);
+		return;
+	}
+	else if(solver == "nn+or2opt")
+	{
+		nearestNeighbourTour(points, 0, tour);
+		LocalSearchOptions search_options;
+		search_options.closed_tour = options.closed_tour;
+		LocalSearch local_search(points, search_options);
+		local_search.or2Opt(tour);
+		return;
+	}
+
+	// the other ones are engines of solver.h, they return by the deadline
+	Solver* engine;
+	if(solver == "nn")
+		engine = new ConstructionSolver(NEAREST_NEIGHBOUR_TOUR, 0, options.closed_tour);
+	else if(solver == "hilbert")
+		engine = new ConstructionSolver(HILBERT_TOUR, 0, options.closed_tour);
+	else if(solver == "serpentine")
+		engine = new ConstructionSolver(SERPENTINE_TOUR, 0, options.closed_tour);
+	else if(solver == "greedy")
+		engine = new ConstructionSolver(GREEDY_TOUR, 0, options.closed_tour);
+	else if(solver == "nn+ga")
+		engine = new GeneticSolver(20, 1000000, 30, seed, options.closed_tour); // the nearest neighbour tour until Genetic beats it
+	else
+	{
+		LinKernighanOptions lk_options;
+		lk_options.closed_tour = options.closed_tour;
+		lk_options.seed = seed;
+		engine = new LinKernighanSolver(lk_options);
+	}
+
+	BestTour best;
+	engine->solve(points, 0, deadlineIn(options.seconds), best);
+	best.get(tour);
+	delete engine;
+}
+
+
+/*
+	Runs a solver in a child process: the child sends the length and the time of its
+	tour through a pipe, its peak resident memory comes from wait4.
+*/
+static void measureRun(const string& solver, const vector<Point2D>& points, const Graph* graph, const BenchmarkOptions& options, RunResult& result)
+{
+	int channel[2];
+	if(pipe(channel) != 0)
+	{
+		cout << "Error: can't create a pipe\n";
+		exit(1);
+	}
+
+	pid_t child = fork();
+	if(child < 0)
+	{
+		cout << "Error: can't fork\n";
+		exit(1);
+	}
+	else if(child == 0)
+	{
+		close(channel[0]);
+
+		vector<int> tour;
+		chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+		runSolver(solver, points, options, result.seed, tour);
+		RunOutput output;
+		output.seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+		output.valid = isValidTour(tour, points.size());
+		if(!output.valid)
+			output.length = -1;
+		else if(graph != NULL)
+			output.length = graph->tourCost(tour);
+		else
+			output.length = pathLength(points, tour, options.closed_tour, EuclideanMetric());
+
+		if(!options.tours_dir.empty() && output.valid)
+		{
+			stringstream tour_file;
+			tour_file << options.tours_dir << '/' << result.instance << '-' << solver << '-' << result.run << ".tour";
+			writeTsplibTour(tour_file.str(), result.instance, tour, (int)(output.length + 0.5));
+		}
+
+		ssize_t written = write(channel[1], &output, sizeof(output));
+		close(channel[1]);
+		_exit(written == (ssize_t)sizeof(output) ? 0 : 1);
+	}
+
+	close(channel[1]);
+	RunOutput output;
+	ssize_t size_read = read(channel[0], &output, sizeof(output));
+	close(channel[0]);
+
+	int status;
+	struct rusage usage;
+	wait4(child, &status, 0, &usage);
+
+	if(size_read != (ssize_t)sizeof(output) || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+	{
+		output.length = -1;
+		output.seconds = 0;
+		output.valid = 0;
+	}
+
+	result.length = output.length;
+	result.seconds = output.seconds;
+	result.valid = output.valid != 0;
+#ifdef __APPLE__
+	result.peak_rss_kb = usage.ru_maxrss / 1024; // bytes on macOS
+#else
+	result.peak_rss_kb = usage.ru_maxrss; // kilobytes on Linux
+#endif
+}
+
+
+static void writeCsv(const vector<RunResult>& results)
+{
+	cout << "instance,points,solver,run,seed,length,gap_percent,seconds,peak_rss_kb,valid\n";
+	for(size_t i = 0; i < results.size(); i++)
+	{
+		const RunResult& r = results[i];
+		cout << r.instance << ',' << r.points << ',' << r.solver << ',' << r.run << ',' << r.seed << ','
+			<< r.length << ',' << r.gap << ',' << r.seconds << ',' << r.peak_rss_kb << ',' << (r.valid ? 1 : 0) << '\n';
+	}
+}
+
+
+static void writeJson(const vector<RunResult>& results)
+{
+	cout << "[\n";
+	for(size_t i = 0; i < results.size(); i++)
+	{
+		const RunResult& r = results[i];
+		cout << "  {\"instance\": \"" << r.instance << "\", \"points\": " << r.points << ", \"solver\": \"" << r.solver
+			<< "\", \"run\": " << r.run << ", \"seed\": " << r.seed << ", \"length\": " << r.length
+			<< ", \"gap_percent\": " << r.gap << ", \"seconds\": " << r.seconds << ", \"peak_rss_kb\": " << r.peak_rss_kb
+			<< ", \"valid\": " << (r.valid ? "true" : "false") << "}" << ((i + 1 < results.size()) ? "," : "") << '\n';
+	}
+	cout << "]\n";
+}
+
+
+int main(int argc, char* argv[])
+{
+	BenchmarkOptions options = parseArguments(argc, argv);
+
+	map<string, double> best_known;
+	if(!options.best_file.empty())
+		loadBestLengths(options.best_file, best_known);
+
+	vector<string> files;
+	for(size_t i = 0; i < options.paths.size(); i++)
+		findInstances(options.paths[i], files);
+
+	cout.precision(10);
+	cerr.precision(6);
+
+	vector<RunResult> results;
+	vector<Point2D> points;
+	for(size_t f = 0; f < files.size(); f++)
+	{
+		string instance = baseName(files[f]);
+		BenchmarkOptions instance_options = options;
+		Graph* graph = NULL; // weights of a TSPLIB instance
+		if(hasExtension(files[f], ".tsp"))
+		{
+			// the solvers work on the coordinates, the optimal lengths are of closed tours
+			graph = new Graph(files[f]);
+			points = graph->getPoints();
+			instance = graph->getName().empty() ? instance.substr(0, instance.size() - 4) : graph->getName();
+			instance_options.closed_tour = true;
+		}
+		else
+			loadPoints(files[f], points);
+
+		if(points.empty())
+		{
+			cerr << instance << ": no points, skipped\n";
+			delete graph;
+			continue;
+		}
+
+		size_t first_result = results.size();
+		for(size_t s = 0; s < options.solvers.size(); s++)
+		{
+			for(int run = 0; run < options.runs; run++)
+			{
+				RunResult result;
+				result.instance = instance;
+				result.points = points.size();
+				result.solver = options.solvers[s];
+				result.run = run;
+				result.seed = options.seed + run;
+				measureRun(result.solver, points, graph, instance_options, result);
+				results.push_back(result);
+
+				// progress on the standard error, the results on the standard output
+				cerr << instance << ' ' << result.solver << " run " << run + 1 << '/' << options.runs << ": "
+					<< result.length << " in " << result.seconds << " s" << (result.valid ? "" : " (invalid tour)") << '\n';
+			}
+		}
+
+		// the gap from the best known length, or from the best tour of the benchmark
+		double best = -1;
+		if(best_known.count(instance))
+			best = best_known[instance];
+		else
+		{
+			for(size_t i = first_result; i < results.size(); i++)
+				if(results[i].valid && (best < 0 || results[i].length < best))
+					best = results[i].length;
+		}
+		for(size_t i = first_result; i < results.size(); i++)
+			results[i].gap = (results[i].valid && best > 0) ? 100.0 * (results[i].length - best) / best : -1;
+		delete graph;
+	}
+
+	if(options.json)
+		writeJson(results);
+	else
+		writeCsv(results);
+	return 0;
+}
@@ -0,0 +1,644 @@
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <set>
+#include <algorithm>
+#include <new>
+#include <thread>
+#include <stdlib.h>
+#include <math.h>
+#include <stdio.h> // remove
+#include <unistd.h> // getpid
+#include "tsp.h"
+#include "local_search.h"
+#include "lin_kernighan.h"
+#include "construction.h"
+#include "streaming.h"
+#include "color_plan.h"
+using namespace std;
+
+
+/*
+	Checks of Genetic and of the engines of tsp-library on the cases the solvers
+	can meet (make test): each failed check is printed and the exit status is 1
+	if any of them failed.
+*/
+
+
+static int failed_checks = 0;
+static long allocations = 0; // calls of operator new, to check the code that shouldn't allocate
+
+
+void* operator new(size_t size)
+{
+	allocations++;
+	void* memory = malloc(size ? size : 1);
+	if(memory == NULL)
+		throw bad_alloc();
+	return memory;
+}
+
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+
+static void check(bool condition, const string& what)
+{
+	if(!condition)
+	{
+		cout << "FAILED: " << what << "\n";
+		failed_checks++;
+	}
+}
+
+
+// the cost and the hash of a child from its parent (segmentCost) against a full recomputation
+static void checkSegmentCost(Graph& graph, const string& name)
+{
+	Genetic genetic(&graph, 10, 10, 0, false);
+	Random random(1);
+	int V = graph.V;
+
+	vector<int> parent;
+	for(int i = 0; i < V; i++)
+		parent.push_back(i);
+
+	for(int first = 0; first < V; first++)
+	{
+		for(int last = first; last < V; last++)
+		{
+			random.shuffle(parent.begin(), parent.end());
+			int parent_cost = genetic.isValidSolution(parent);
+
+			// the child is the parent with the segment [first, last] in another order
+			vector<int> child = parent;
+			random.shuffle(child.begin() + first, child.begin() + last + 1);
+
+			uint64_t hash = genetic.solutionHash(parent);
+			int cost = genetic.segmentCost(parent, parent_cost, child, first, last, hash);
+			string segment = name + " segment [" + to_string(first) + ", " + to_string(last) + "]";
+			check(cost == genetic.isValidSolution(child), segment + ": cost " + to_string(cost) + " != " + to_string(genetic.isValidSolution(child)));
+			check(hash == genetic.solutionHash(child), segment + ": hash");
+		}
+	}
+}
+
+
+static void testSegmentCost()
+{
+	Random random(2);
+	vector<Point2D> points;
+	for(int i = 0; i < 9; i++)
+		points.push_back({(float)random.uniform(100), (float)random.uniform(100)});
+	Graph geometric(points, 0);
+	checkSegmentCost(geometric, "geometric");
+
+	// every edge with a weight of its own in each direction
+	Graph asymmetric(7, 0);
+	for(int src = 0; src < 7; src++)
+		for(int dest = 0; dest < 7; dest++)
+			if(src != dest)
+				asymmetric.addEdge(src, dest, random.uniform(50) + 1);
+	checkSegmentCost(asymmetric, "asymmetric");
+}
+
+
+/*
+	Runs on 2, 3 and 4 points, where the substring of the crossover has few positions
+	to move: the best solution has to be a tour from the initial vertex with its cost.
+	The writes out of the children are caught building with -fsanitize=address.
+*/
+static void testFewPoints()
+{
+	for(int amount_points = 2; amount_points <= 4; amount_points++)
+	{
+		for(int mode = 0; mode < 2; mode++)
+		{
+			vector<Point2D> points;
+			for(int i = 0; i < amount_points; i++)
+				points.push_back({(float)(10 * i), (float)(i % 2)});
+			Graph graph(points, 0);
+
+			Genetic genetic(&graph, 10, 200, 30, false);
+			genetic.setSeed(amount_points);
+			if(mode == 1)
+				genetic.setGenerationalMode(8, 2);
+			genetic.runUntil(chrono::steady_clock::time_point::max(), NULL);
+
+			string run = to_string(amount_points) + " points" + ((mode == 1) ? " (generational)" : "");
+			vector<int> best = genetic.getBestSolution();
+			check((int)best.size() == amount_points && best[0] == 0, run + ": the best solution isn't a tour from 0");
+			if((int)best.size() == amount_points)
+				check(genetic.getCostBestSolution() == genetic.isValidSolution(best), run + ": cost of the best solution");
+		}
+	}
+}
+
+
+// HashSet against std::set, with many more erases than hashes (tombstones)
+static void testHashSet()
+{
+	Random random(3);
+	HashSet hashes;
+	hashes.reserve(50);
+	set<uint64_t> expected;
+
+	for(int i = 0; i < 100000; i++)
+	{
+		// few different keys, so the same ones are inserted and erased again
+		uint64_t key = random.next() % 200;
+		if(random.uniform(2) == 0 && expected.size() < 50)
+			check(hashes.insert(key) == expected.insert(key).second, "HashSet::insert " + to_string(key));
+		else
+		{
+			hashes.erase(key);
+			expected.erase(key);
+		}
+		check(hashes.count(key) == expected.count(key), "HashSet::count " + to_string(key));
+	}
+	check(hashes.size() == expected.size(), "HashSet::size");
+}
+
+
+// the generations use the memory allocated by the constructor: 20 times more generations, the same allocations
+static void testGenerationsDontAllocate()
+{
+	Random random(4);
+	vector<Point2D> points;
+	for(int i = 0; i < 100; i++)
+		points.push_back({(float)random.uniform(1000), (float)random.uniform(1000)});
+	Graph graph(points, 0);
+
+	for(int mode = 0; mode < 2; mode++)
+	{
+		long made[2];
+		for(int run = 0; run < 2; run++)
+		{
+			Genetic genetic(&graph, 20, (run == 0) ? 500 : 10000, 30, false);
+			if(mode == 1)
+				genetic.setGenerationalMode(16, 1);
+			long before = allocations;
+			genetic.runUntil(chrono::steady_clock::time_point::max(), NULL);
+			made[run] = allocations - before;
+		}
+		check(made[0] == made[1], string((mode == 1) ? "generational" : "steady state") + " generations allocate: "
+			+ to_string(made[0]) + " allocations in 500 generations, " + to_string(made[1]) + " in 10000");
+	}
+}
+
+
+static vector<Point2D> randomPoints(int amount, uint64_t seed)
+{
+	Random random(seed);
+	vector<Point2D> points;
+	for(int i = 0; i < amount; i++)
+		points.push_back({(float)random.uniform(1000), (float)random.uniform(1000)});
+	return points;
+}
+
+
+// a tour of an engine: every point once, from the point that started the tour given to it
+static void checkTour(const vector<int>& tour, int amount_points, int first_point, const string& what)
+{
+	vector<bool> seen(amount_points, false);
+	bool permutation = (int)tour.size() == amount_points;
+	for(size_t i = 0; permutation && i < tour.size(); i++)
+	{
+		permutation = tour[i] >= 0 && tour[i] < amount_points && !seen[tour[i]];
+		if(permutation)
+			seen[tour[i]] = true;
+	}
+	check(permutation, what + ": the tour isn't a permutation of the points");
+	check(permutation && (first_point == -1 || tour[0] == first_point), what + ": the tour doesn't start from " + to_string(first_point));
+}
+
+
+// the moves of LocalSearch on random tours, open and closed, from another first point each time
+static void testLocalSearch()
+{
+	for(int closed = 0; closed < 2; closed++)
+	{
+		for(int amount_points = 2; amount_points <= 300; amount_points += (amount_points < 8) ? 1 : 73)
+		{
+			vector<Point2D> points = randomPoints(amount_points, amount_points);
+			LocalSearchOptions options;
+			options.closed_tour = closed;
+			LocalSearch search(points, options);
+			Random random(5);
+
+			for(int kind = 0; kind < 3; kind++)
+			{
+				vector<int> tour;
+				for(int i = 0; i < amount_points; i++)
+					tour.push_back(i);
+				random.shuffle(tour.begin(), tour.end());
+				double before = search.tourLength(tour);
+				int first_point = tour[0];
+
+				LocalSearchReport report = (kind == 0) ? search.twoOpt(tour) : ((kind == 1) ? search.orOpt(tour) : search.or2Opt(tour));
+				string run = string((kind == 0) ? "2-opt" : ((kind == 1) ? "Or-opt" : "2-opt and Or-opt")) + " on "
+					+ to_string(amount_points) + " points" + (closed ? " (closed)" : " (open)");
+				checkTour(tour, amount_points, first_point, run);
+				check(search.tourLength(tour) <= before + 1e-3, run + ": the tour is longer");
+				check(fabs(search.tourLength(tour) - report.final_length) < 1e-3, run + ": length of the report");
+			}
+		}
+	}
+}
+
+
+/*
+	Random 2-opt moves recorded in the journal of LocalSearch and then undone: the tour
+	must be the one before the moves (the kicks of Lin-Kernighan are undone this way).
+*/
+class JournalOfMoves : public LocalSearch
+{
+public:
+	JournalOfMoves(const vector<Point2D>& points, const LocalSearchOptions& options) : LocalSearch(points, options) {}
+	bool movesAreUndone(vector<int>& tour, Random& random, int amount_moves)
+	{
+		loadTour(tour);
+		double initial_length = current_length;
+		keep_journal = true;
+		for(int move = 0; move < amount_moves; move++)
+		{
+			int t1 = random.uniform(amount_points);
+			int t3 = random.uniform(amount_points);
+			int t2 = next(t1);
+			int t4 = next(t3);
+			if(t1 != t3 && t2 != t3 && t4 != t1 && !isFixed(t1, t2) && !isFixed(t3, t4))
+				makeTwoOptMove(t1, t2, t3, t4);
+		}
+		undoJournal();
+		keep_journal = false;
+
+		vector<int> undone;
+		storeTour(undone);
+		return undone == tour && fabs(current_length - initial_length) < 1e-3;
+	}
+};
+
+
+static void testLinKernighan()
+{
+	for(int closed = 0; closed < 2; closed++)
+	{
+		for(int amount_points = 5; amount_points <= 300; amount_points += (amount_points < 8) ? 1 : 73)
+		{
+			vector<Point2D> points = randomPoints(amount_points, 10 + amount_points);
+			string instance = to_string(amount_points) + " points" + (closed ? " (closed)" : " (open)");
+			Random random(6);
+
+			LinKernighanOptions options;
+			options.closed_tour = closed;
+			JournalOfMoves journal(points, options);
+			vector<int> tour;
+			for(int i = 0; i < amount_points; i++)
+				tour.push_back(i);
+			random.shuffle(tour.begin(), tour.end());
+			check(journal.movesAreUndone(tour, random, 20), "undo of 2-opt moves on " + instance);
+
+			// the same local optimum, then 200 kicks: a kick that doesn't improve is undone
+			options.time_limit = 0;
+			LinKernighan without_kicks(points, options);
+			options.max_kicks = 200;
+			LinKernighan with_kicks(points, options);
+			vector<int> optimum = tour;
+			without_kicks.solve(optimum);
+			vector<int> kicked = tour;
+			LocalSearchReport report = with_kicks.solve(kicked);
+
+			checkTour(kicked, amount_points, tour[0], "LK kicks on " + instance);
+			check(report.kicks == 200, "LK kicks on " + instance + ": " + to_string(report.kicks) + " kicks instead of 200");
+			check(with_kicks.tourLength(kicked) <= without_kicks.tourLength(optimum) + 1e-3, "LK kicks on " + instance + ": the tour is longer than the local optimum");
+			check(fabs(with_kicks.tourLength(kicked) - report.final_length) < 1e-3, "LK kicks on " + instance + ": length of the report");
+		}
+	}
+}
+
+
+static double pathLength(const vector<Point2D>& points, const vector<int>& tour)
+{
+	double total = 0;
+	for(size_t i = 0; i + 1 < tour.size(); i++)
+		total += hypot(points[tour[i]].x - points[tour[i + 1]].x, points[tour[i]].y - points[tour[i + 1]].y);
+	return total;
+}
+
+
+/*
+	The constructions on random points, on duplicates and on points in a line: a permutation
+	from first_point. On a 16 x 16 lattice from a corner the Hilbert curve, the serpentine
+	(with the step of the lattice) and greedy are paths of 255 steps of the lattice, the
+	nearest neighbour jumps back at the end of some rows but it's far from a random tour.
+*/
+static void testConstructions()
+{
+	const char* names[] = {"nearest neighbour", "Hilbert", "serpentine", "greedy"};
+	Random random(7);
+
+	for(int amount_points = 1; amount_points <= 500; amount_points += (amount_points < 8) ? 1 : 123)
+	{
+		for(int shape = 0; shape < 3; shape++)
+		{
+			vector<Point2D> points = randomPoints(amount_points, 20 + amount_points);
+			for(int i = 0; i < amount_points; i++)
+			{
+				if(shape == 1)
+					points[i] = points[i / 2]; // each point twice
+				else if(shape == 2)
+					points[i].y = 5; // a horizontal line
+			}
+			string instance = to_string(amount_points) + ((shape == 0) ? " random points" : ((shape == 1) ? " points with duplicates" : " points in a line"));
+
+			for(int construction = NEAREST_NEIGHBOUR_TOUR; construction <= GREEDY_TOUR; construction++)
+			{
+				int first_point = random.uniform(amount_points);
+				vector<int> tour;
+				constructTour(construction, points, first_point, tour);
+				checkTour(tour, amount_points, first_point, string(names[construction]) + " on " + instance);
+			}
+		}
+	}
+
+	vector<Point2D> lattice;
+	for(int y = 0; y < 16; y++)
+		for(int x = 0; x < 16; x++)
+			lattice.push_back({(float)(10 * x), (float)(10 * y)});
+	vector<int> shuffled;
+	for(int i = 0; i < (int)lattice.size(); i++)
+		shuffled.push_back(i);
+	random.shuffle(shuffled.begin() + 1, shuffled.end());
+
+	for(int construction = NEAREST_NEIGHBOUR_TOUR; construction <= GREEDY_TOUR; construction++)
+	{
+		vector<int> tour;
+		constructTour(construction, lattice, 0, tour, 10);
+		double length = pathLength(lattice, tour);
+		string run = string(names[construction]) + " on a lattice";
+		checkTour(tour, lattice.size(), 0, run);
+		if(construction != NEAREST_NEIGHBOUR_TOUR)
+			check(fabs(length - 2550) < 1e-3, run + ": length " + to_string(length) + " instead of 2550");
+		else
+			check(length < pathLength(lattice, shuffled) / 4, run + ": length " + to_string(length) + " of about a random tour");
+	}
+}
+
+
+/*
+	StreamingTour: with tours shorter than commit_ahead next() returns every point once and
+	then -1. With the worker running, the points committed ahead of the consumer (the first
+	ones of getTour) are the next ones returned, whether the consumer is faster than the
+	slices (the guard moves further) or slower (the slices improve the suffix).
+*/
+static void testStreamingTour()
+{
+	LinKernighanOptions options;
+	options.time_limit = 0.01;
+
+	for(int amount_points = 0; amount_points <= 5; amount_points++)
+	{
+		for(int commit_ahead = 1; commit_ahead <= 4; commit_ahead++)
+		{
+			vector<Point2D> points = randomPoints(amount_points, 30 + amount_points);
+			vector<int> tour;
+			for(int i = 0; i < amount_points; i++)
+				tour.push_back(amount_points - 1 - i);
+
+			StreamingTour stream(points, tour, commit_ahead, options);
+			vector<int> streamed;
+			for(int point = stream.next(); point != -1; point = stream.next())
+				streamed.push_back(point);
+			string run = "StreamingTour of " + to_string(amount_points) + " points, " + to_string(commit_ahead) + " ahead";
+			check(streamed == tour, run + ": next() didn't return the tour");
+			check(stream.next() == -1 && stream.remaining() == 0, run + ": next() after the end");
+		}
+	}
+
+	const int amount_points = 2000, commit_ahead = 3;
+	vector<Point2D> points = randomPoints(amount_points, 31);
+	vector<int> tour;
+	for(int i = 0; i < amount_points; i++)
+		tour.push_back(i);
+	Random random(8);
+	random.shuffle(tour.begin() + 1, tour.end());
+
+	StreamingTour stream(points, tour, commit_ahead, options);
+	stream.start();
+	vector<int> streamed, ahead, promised;
+	for(int i = 0; i < amount_points; i++)
+	{
+		// a pause in the middle, so some slices end before the consumer reaches them
+		if(i == amount_points / 4)
+			this_thread::sleep_for(chrono::milliseconds(200));
+
+		stream.getTour(ahead);
+		ahead.resize(min((int)ahead.size(), commit_ahead));
+		for(size_t j = 0; j + 1 < promised.size(); j++)
+			check(ahead[j] == promised[j + 1], "StreamingTour: a committed point changed at point " + to_string(i));
+		promised = ahead;
+
+		streamed.push_back(stream.next());
+		check(!ahead.empty() && streamed.back() == ahead[0], "StreamingTour: next() isn't the committed point at point " + to_string(i));
+	}
+	stream.stop();
+
+	checkTour(streamed, amount_points, tour[0], "StreamingTour with the worker");
+	check(stream.next() == -1, "StreamingTour with the worker: next() after the end");
+	check(stream.getImprovements() > 0, "StreamingTour with the worker: no slice improved the tour");
+}
+
+
+// the cost of a plan measured on its paths: the moves from the start and between the dots, and the changes of color
+static double planCost(const vector<vector<Point2D> >& layers, const Point2D& start, const ColorPlan& plan, double switch_cost)
+{
+	double cost = 0;
+	Point2D position = start;
+	for(size_t i = 0; i < plan.order.size(); i++)
+	{
+		const vector<Point2D>& points = layers[plan.order[i]];
+		const vector<int>& path = plan.paths[i];
+		if(i > 0)
+			cost += switch_cost;
+		cost += hypot(points[path[0]].x - position.x, points[path[0]].y - position.y) + pathLength(points, path);
+		position = points[path.back()];
+	}
+	return cost;
+}
+
+
+/*
+	planColorLayers: every layer with points is painted once along a path of all its points
+	and the cost of the plan is the one of its paths. With a single point in each layer the
+	dynamic program is exact, so it must find the order of the brute force.
+*/
+static void testColorPlan()
+{
+	ColorPlanOptions options;
+	options.time_limit = 0.05;
+	Point2D start = {0, 0};
+
+	// layers far from each other along a line, given in another order, and an empty one
+	vector<vector<Point2D> > layers(4);
+	for(int l = 0; l < 3; l++)
+	{
+		vector<Point2D> points = randomPoints(50 + 30 * l, 40 + l);
+		for(size_t i = 0; i < points.size(); i++)
+			layers[(l + 1) % 3].push_back({points[i].x / 10 + 1000 * l, points[i].y / 10});
+	}
+
+	for(int with_switches = 0; with_switches < 2; with_switches++)
+	{
+		options.switch_cost = with_switches ? 100 : 0;
+		ColorPlan plan;
+		planColorLayers<EuclideanMetric>(layers, start, plan, options);
+
+		string run = string("color plan") + (with_switches ? " with changes of color" : "");
+		check(plan.order == vector<int>({1, 2, 0}), run + ": the layers aren't in the order along the line");
+		for(size_t i = 0; i < plan.order.size() && i < plan.paths.size(); i++)
+			checkTour(plan.paths[i], layers[plan.order[i]].size(), -1, run + ", layer " + to_string(plan.order[i]));
+		if(plan.paths.size() == plan.order.size())
+			check(fabs(plan.cost - planCost(layers, start, plan, options.switch_cost)) < 1e-2, run + ": the cost isn't the cost of the paths");
+	}
+
+	// one point in each layer
+	options.switch_cost = 10;
+	vector<Point2D> dots = randomPoints(6, 41);
+	vector<vector<Point2D> > single(dots.size());
+	vector<int> order;
+	for(size_t l = 0; l < dots.size(); l++)
+	{
+		single[l].push_back(dots[l]);
+		order.push_back(l);
+	}
+
+	double best_cost = -1;
+	do
+	{
+		ColorPlan candidate;
+		candidate.order = order;
+		for(size_t i = 0; i < order.size(); i++)
+			candidate.paths.push_back(vector<int>(1, 0));
+		double cost = planCost(single, start, candidate, options.switch_cost);
+		if(best_cost == -1 || cost < best_cost)
+			best_cost = cost;
+	}
+	while(next_permutation(order.begin(), order.end()));
+
+	ColorPlan plan;
+	planColorLayers<EuclideanMetric>(single, start, plan, options);
+	check(fabs(plan.cost - best_cost) < 1e-2, "color plan of single points: cost " + to_string(plan.cost) + " instead of " + to_string(best_cost));
+}
+
+
+// writes the weights of an EXPLICIT instance in a format of TSPLIB, 7 weights per line (the lines aren't the rows)
+static void writeExplicit(const string& file_name, const string& type, const string& format, const vector<vector<int> >& matrix)
+{
+	int V = matrix.size();
+	ofstream file(file_name.c_str());
+	file << "NAME : explicit\nTYPE : " << type << "\nDIMENSION : " << V << "\n";
+	file << "EDGE_WEIGHT_TYPE : EXPLICIT\nEDGE_WEIGHT_FORMAT : " << format << "\nEDGE_WEIGHT_SECTION\n";
+
+	bool upper = format.find("UPPER") == 0, diagonal = format.find("DIAG") != string::npos;
+	int written = 0;
+	for(int row = 0; row < V; row++)
+	{
+		int first = (format == "FULL_MATRIX") ? 0 : upper ? (diagonal ? row : row + 1) : 0;
+		int last = (format == "FULL_MATRIX" || upper) ? V - 1 : (diagonal ? row : row - 1);
+		for(int column = first; column <= last; column++)
+			file << " " << matrix[row][column] << ((++written % 7 == 0) ? "\n" : "");
+	}
+	file << "\nEOF\n";
+}
+
+
+/*
+	TSPLIB instances: the weights of a symmetric matrix written with each EXPLICIT format and of
+	an asymmetric FULL_MATRIX must be the edges of the graph, the cost of an EUC_2D tour is made
+	of rounded distances, and a tour written in a .tour file is read back the same.
+*/
+static void testTsplib()
+{
+	string base = "/tmp/genetic-test-" + to_string(getpid());
+	Random random(9);
+	const int V = 6;
+	vector<vector<int> > symmetric(V, vector<int>(V, 0)), asymmetric(V, vector<int>(V, 0));
+	for(int row = 0; row < V; row++)
+	{
+		for(int column = 0; column < V; column++)
+		{
+			asymmetric[row][column] = (row == column) ? 0 : 1 + random.uniform(1000);
+			if(row < column)
+				symmetric[row][column] = symmetric[column][row] = 1 + random.uniform(1000);
+		}
+	}
+
+	const char* formats[] = {"FULL_MATRIX", "UPPER_ROW", "LOWER_ROW", "UPPER_DIAG_ROW", "LOWER_DIAG_ROW"};
+	for(int f = 0; f <= 5; f++)
+	{
+		bool atsp = (f == 5);
+		string format = atsp ? "FULL_MATRIX" : formats[f];
+		const vector<vector<int> >& matrix = atsp ? asymmetric : symmetric;
+		writeExplicit(base + ".tsp", atsp ? "ATSP" : "TSP", format, matrix);
+
+		Graph graph(base + ".tsp");
+		string run = string(atsp ? "ATSP " : "TSP ") + format;
+		check(graph.V == V && graph.getName() == "explicit", run + ": dimension or name");
+		for(int src = 0; src < V && graph.V == V; src++)
+			for(int dest = 0; dest < V; dest++)
+				if(src != dest)
+					check(graph.existsEdge(src, dest) == matrix[src][dest], run + ": weight of " + to_string(src) + " -> " + to_string(dest));
+	}
+
+	// EUC_2D: 3-4-5 triangles, and a distance of 1.5 rounded to 2
+	{
+		ofstream file((base + ".tsp").c_str());
+		file << "NAME : triangle\nTYPE : TSP\nDIMENSION : 4\nEDGE_WEIGHT_TYPE : EUC_2D\nNODE_COORD_SECTION\n";
+		file << "1 0 0\n2 3 0\n3 3 4\n4 1.5 4\nEOF\n";
+	}
+	Graph euclidean(base + ".tsp");
+	vector<int> tour = {0, 1, 2, 3};
+	check(euclidean.tourCost(tour) == 3 + 4 + 2 + 4, "EUC_2D: cost " + to_string(euclidean.tourCost(tour)) + " instead of 13");
+
+	vector<int> written = {3, 0, 2, 1}, read;
+	writeTsplibTour(base + ".tour", "triangle", written, 13);
+	readTsplibTour(base + ".tour", read);
+	check(read == written, ".tour file: the tour read isn't the tour written");
+
+	remove((base + ".tsp").c_str());
+	remove((base + ".tour").c_str());
+}
+
+
+int main()
+{
+	testSegmentCost();
+	testFewPoints();
+	testHashSet();
+	testGenerationsDontAllocate();
+	testLocalSearch();
+	testLinKernighan();
+	testConstructions();
+	testStreamingTour();
+	testColorPlan();
+	testTsplib();
+
+	if(failed_checks > 0)
+	{
+		cout << failed_checks << " checks failed\n";
+		return 1;
+	}
+	cout << "all checks passed\n";
+	return 0;
+}
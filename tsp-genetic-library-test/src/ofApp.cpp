@@ -4,7 +4,7 @@
 //--------------------------------------------------------------
 void ofApp::setup(){
 
-    srand(time(NULL)); // random numbers
+    uint64_t seed = time(NULL); // a different run each time, a fixed seed repeats a run
 	
 	// creates the graph1 with parameters: number of vertexes and initial vertex
 	Graph * graph1 = new Graph(5, 0);
@@ -63,12 +63,19 @@ void ofApp::setup(){
 	graph3->addEdge(2, 1, 35);
 	
 	// creates random graph, parameter true is for generate the graph
-	Graph * graph4 = new Graph(50, 0, true);
+	// optional parameters: storage and the seed of the random graph
+	Graph * graph4 = new Graph(50, 0, true, Graph::FULL, seed);
 	graph4->showInfoGraph();
 	
 	// parameters: the graph, population size, generations and mutation rate
 	// optional parameters: show_population
 	Genetic genetic(graph4, 10, 1000, 5, true);
+	genetic.setSeed(seed);
+	
+	// statistics every 10 generations (bin/data/genetic_stats.csv), to see when the population stops improving
+	GeneticTelemetry telemetry(10);
+	telemetry.openCsv(ofToDataPath("genetic_stats.csv"));
+	genetic.setTelemetry(&telemetry);
 
 	const clock_t begin_time = clock(); // gets time
 	genetic.run(); // runs the genetic algorithm
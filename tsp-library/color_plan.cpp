@@ -0,0 +1,207 @@
+#include <iostream>
+#include <algorithm> // next_permutation
+#include <limits> // infinity
+#include "color_plan.h"
+#include "construction.h"
+#include "spatial.h"
+using namespace std;
+
+
+// cost of an entry or an exit that can't be reached
+static const double NO_COST = numeric_limits<double>::infinity();
+
+
+// closed tour of a layer and the position of each point in it
+struct LayerTour
+{
+	vector<int> tour; // the closed tour
+	vector<int> position; // position of each point in tour
+	double length; // length of the closed tour
+	int next(int point) const { return tour[(position[point] + 1) % tour.size()]; }
+	int prev(int point) const { return tour[(position[point] + tour.size() - 1) % tour.size()]; }
+};
+
+
+// the dynamic program at a layer, for each point of the layer
+struct LayerStep
+{
+	vector<double> entry_cost; // cost of the job up to the point as the first dot of the layer
+	vector<int> entry_from; // exit of the previous layer of each entry (-1 from the start)
+	vector<double> exit_cost; // cost of the job up to the point as the last dot of the layer
+	vector<int> exit_entry; // entry of the layer of each exit
+};
+
+
+template<typename Metric>
+static void buildLayerTour(const vector<Point2D>& points, const ColorPlanOptions& options, double time_limit, const Metric& metric, LayerTour& layer)
+{
+	greedyTour(points, 0, layer.tour);
+
+	// LinKernighan needs a few points to move
+	if(points.size() > 4)
+	{
+		LinKernighanOptions tour_options = options;
+		tour_options.closed_tour = true;
+		tour_options.time_limit = time_limit;
+		BasicLinKernighan<Metric> lin_kernighan(points, tour_options, metric);
+		lin_kernighan.solve(layer.tour);
+	}
+
+	layer.position.resize(points.size());
+	for(size_t i = 0; i < layer.tour.size(); i++)
+		layer.position[layer.tour[i]] = i;
+	layer.length = pathLength(points, layer.tour, true, metric);
+}
+
+
+/*
+	The path that enters the closed tour at e and leaves from its neighbour x goes
+	around the tour without the edge (e, x): x is reached from next(x) following
+	prev, or from prev(x) following next.
+*/
+template<typename Metric>
+static void findExits(const vector<Point2D>& points, const LayerTour& layer, const Metric& metric, LayerStep& step)
+{
+	int amount_points = points.size();
+	step.exit_cost.assign(amount_points, NO_COST);
+	step.exit_entry.assign(amount_points, -1);
+
+	for(int x = 0; x < amount_points; x++)
+	{
+		for(int side = 0; side < 2; side++)
+		{
+			int e = (side == 0) ? layer.next(x) : layer.prev(x);
+			if(step.entry_cost[e] == NO_COST)
+				continue;
+
+			// a layer of a single point has no edge
+			double cost = step.entry_cost[e] + layer.length - ((e == x) ? 0 : metric(points[e], points[x]));
+			if(cost < step.exit_cost[x])
+			{
+				step.exit_cost[x] = cost;
+				step.exit_entry[x] = e;
+			}
+		}
+	}
+}
+
+
+// the open path of a layer from entry to exit (a neighbour of entry in the closed tour)
+static void layerPath(const LayerTour& layer, int entry, int exit, vector<int>& path)
+{
+	bool forward = (layer.prev(entry) == exit);
+
+	path.clear();
+	int point = entry;
+	for(size_t i = 0; i < layer.tour.size(); i++)
+	{
+		path.push_back(point);
+		point = forward ? layer.next(point) : layer.prev(point);
+	}
+}
+
+
+template<typename Metric>
+void planColorLayers(const vector<vector<Point2D> >& layers, const Point2D& start, ColorPlan& plan, const ColorPlanOptions& options, const Metric& metric)
+{
+	if(options.switch_cost < 0) // checks if a change of color saves time
+	{
+		cout << "Error: switch_cost < 0\n";
+		exit(1);
+	}
+
+	plan = ColorPlan();
+
+	vector<int> order; // the layers with points, in the first order to try
+	for(size_t l = 0; l < layers.size(); l++)
+		if(!layers[l].empty())
+			order.push_back(l);
+	if(order.empty())
+		return;
+
+	// the tours don't depend on the order, the time is shared by the layers
+	vector<LayerTour> tours(layers.size());
+	vector<SpatialGrid> grids; // the entries of each layer near an exit of the previous one
+	vector<int> grid_of(layers.size(), -1);
+	for(size_t i = 0; i < order.size(); i++)
+	{
+		int l = order[i];
+		buildLayerTour(layers[l], options, options.time_limit / order.size(), metric, tours[l]);
+		grid_of[l] = grids.size();
+		grids.push_back(SpatialGrid(layers[l]));
+	}
+
+	vector<LayerStep> steps(order.size()), best_steps;
+	vector<int> best_order;
+	double best_cost = NO_COST;
+	do
+	{
+		for(size_t i = 0; i < order.size(); i++)
+		{
+			const vector<Point2D>& points = layers[order[i]];
+			LayerStep& step = steps[i];
+			step.entry_cost.assign(points.size(), NO_COST);
+			step.entry_from.assign(points.size(), -1);
+
+			if(i == 0)
+			{
+				// every point can be the first dot of the job
+				for(size_t e = 0; e < points.size(); e++)
+					step.entry_cost[e] = metric(start, points[e]);
+			}
+			else
+			{
+				// each exit of the previous layer goes to the nearest point of this one
+				const vector<Point2D>& previous_points = layers[order[i - 1]];
+				const LayerStep& previous = steps[i - 1];
+				for(size_t x = 0; x < previous_points.size(); x++)
+				{
+					if(previous.exit_cost[x] == NO_COST)
+						continue;
+
+					const Point2D& p = previous_points[x];
+					int e = grids[grid_of[order[i]]].nearestPoint(p.x, p.y);
+					double cost = previous.exit_cost[x] + options.switch_cost + metric(p, points[e]);
+					if(cost < step.entry_cost[e])
+					{
+						step.entry_cost[e] = cost;
+						step.entry_from[e] = x;
+					}
+				}
+			}
+
+			findExits(points, tours[order[i]], metric, step);
+		}
+
+		const LayerStep& last = steps.back();
+		double cost = *min_element(last.exit_cost.begin(), last.exit_cost.end());
+		if(cost < best_cost)
+		{
+			best_cost = cost;
+			best_order = order;
+			best_steps = steps;
+		}
+	}
+	while(next_permutation(order.begin(), order.end()));
+
+	// from the cheapest exit of the last layer back to the start
+	plan.order = best_order;
+	plan.cost = best_cost;
+	plan.paths.resize(best_order.size());
+
+	const LayerStep& last = best_steps.back();
+	int x = min_element(last.exit_cost.begin(), last.exit_cost.end()) - last.exit_cost.begin();
+	for(int i = best_order.size() - 1; i >= 0; i--)
+	{
+		int e = best_steps[i].exit_entry[x];
+		layerPath(tours[best_order[i]], e, x, plan.paths[i]);
+		x = best_steps[i].entry_from[e];
+	}
+}
+
+
+// the plans of the metrics of metric.h
+template void planColorLayers<EuclideanMetric>(const vector<vector<Point2D> >&, const Point2D&, ColorPlan&, const ColorPlanOptions&, const EuclideanMetric&);
+template void planColorLayers<ManhattanMetric>(const vector<vector<Point2D> >&, const Point2D&, ColorPlan&, const ColorPlanOptions&, const ManhattanMetric&);
+template void planColorLayers<ChebyshevMetric>(const vector<vector<Point2D> >&, const Point2D&, ColorPlan&, const ColorPlanOptions&, const ChebyshevMetric&);
+template void planColorLayers<MachineTimeMetric>(const vector<vector<Point2D> >&, const Point2D&, ColorPlan&, const ColorPlanOptions&, const MachineTimeMetric&);
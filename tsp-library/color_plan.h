@@ -0,0 +1,47 @@
+#ifndef COLOR_PLAN_H
+#define COLOR_PLAN_H
+
+#include <vector>
+#include "tsp.h" // Point2D
+#include "lin_kernighan.h"
+#include "metric.h"
+
+
+// parameters of the plan of the color layers (time_limit is shared by the tours of the layers)
+struct ColorPlanOptions : public LinKernighanOptions
+{
+	double switch_cost; // cost of a change of color, in the unit of the metric
+	ColorPlanOptions() : switch_cost(0) { time_limit = 0.5; }
+};
+
+
+// a job of the machine: the layers one after the other, each one an open path
+struct ColorPlan
+{
+	std::vector<int> order; // the layers in the order they are painted (the empty ones aren't there)
+	std::vector<std::vector<int> > paths; // path of each layer of order, indexes of its points from the first dot to the last
+	double cost; // cost of the job from the start position: moves, dots and changes of color
+	ColorPlan() : cost(0) {}
+};
+
+
+/*
+	Plans the dots of some colors (layers, one for each gun or paint) as a single job
+	that starts from the position start, with the metric of the machine.
+
+	Each layer is a tour of its own: a closed tour built by greedyTour and improved by
+	BasicLinKernighan, then opened at the edge that suits the layers before and after
+	it. An open path that enters a closed tour at e and leaves from its neighbour x
+	costs the closed tour minus the edge (e, x), so every entry point has two exits
+	whose costs are known without solving the layer again.
+
+	For each order of the layers (all of them, the colors are few) a dynamic program
+	goes from the start through the layers: the cost of each exit of a layer is the
+	best entry that leads to it, and the entries of the next layer are reached from
+	the exits of the previous one through their nearest point (SpatialGrid). The plan
+	is the cheapest order with its entries and exits.
+*/
+template<typename Metric>
+void planColorLayers(const std::vector<std::vector<Point2D> >& layers, const Point2D& start, ColorPlan& plan, const ColorPlanOptions& options = ColorPlanOptions(), const Metric& metric = Metric());
+
+#endif
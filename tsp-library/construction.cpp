@@ -0,0 +1,312 @@
+#include <iostream>
+#include <algorithm> // sort, rotate, find
+#include "construction.h"
+#include "spatial.h"
+using namespace std;
+
+
+// checks the parameters shared by the constructions
+static void checkPoints(const vector<Point2D>& points, int first_point)
+{
+	if(first_point < 0 || first_point >= (int)points.size()) // checks if first_point is a point
+	{
+		cout << "Error: first_point out of range\n";
+		exit(1);
+	}
+}
+
+
+/*
+	The visited points are removed from a SpatialGrid, so each step is a ring search
+	around the current point instead of a scan of all the points: about O(n log n)
+	for the dots of a drawing (the searches are long only when the path jumps across
+	an empty area).
+*/
+void nearestNeighbourTour(const vector<Point2D>& points, int first_point, vector<int>& tour)
+{
+	tour.clear();
+	if(points.empty())
+		return;
+	checkPoints(points, first_point);
+
+	SpatialGrid grid(points);
+	tour.reserve(points.size());
+
+	int current = first_point;
+	while(current != -1)
+	{
+		tour.push_back(current);
+		grid.remove(current);
+		current = grid.nearestPoint(points[current].x, points[current].y);
+	}
+}
+
+
+// index of the cell (x, y) along a Hilbert curve over a side x side grid (side is a power of 2)
+static uint64_t hilbertIndex(uint32_t side, uint32_t x, uint32_t y)
+{
+	uint64_t index = 0;
+	for(uint32_t s = side / 2; s > 0; s /= 2)
+	{
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		index += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+		// rotates the quadrant
+		if(ry == 0)
+		{
+			if(rx == 1)
+			{
+				x = side - 1 - x;
+				y = side - 1 - y;
+			}
+			swap(x, y);
+		}
+	}
+	return index;
+}
+
+
+// sorts the points by key (ties by index) and rotates the order to start from first_point
+static void sortedTour(const vector<uint64_t>& keys, int first_point, vector<int>& tour)
+{
+	// the keys next to their points, so the sort doesn't jump around keys
+	vector<pair<uint64_t, int> > sorted(keys.size());
+	for(size_t i = 0; i < keys.size(); i++)
+		sorted[i] = make_pair(keys[i], (int)i);
+	sort(sorted.begin(), sorted.end());
+
+	tour.resize(keys.size());
+	for(size_t i = 0; i < sorted.size(); i++)
+		tour[i] = sorted[i].second;
+	rotate(tour.begin(), find(tour.begin(), tour.end(), first_point), tour.end());
+}
+
+
+/*
+	The bounding box is mapped on a 65536 x 65536 grid: points closer than 1/65536 of
+	the box can be in the same cell, their order is the order of their indexes.
+*/
+void hilbertTour(const vector<Point2D>& points, int first_point, vector<int>& tour)
+{
+	tour.clear();
+	if(points.empty())
+		return;
+	checkPoints(points, first_point);
+
+	float min_x = points[0].x, min_y = points[0].y, max_x = min_x, max_y = min_y;
+	for(size_t i = 1; i < points.size(); i++)
+	{
+		min_x = min(min_x, points[i].x);
+		min_y = min(min_y, points[i].y);
+		max_x = max(max_x, points[i].x);
+		max_y = max(max_y, points[i].y);
+	}
+
+	// the same scale on both axes, so the curve isn't stretched
+	const uint32_t side = 1 << 16;
+	double scale = (side - 1) / max((double)max(max_x - min_x, max_y - min_y), 1e-9);
+	vector<uint64_t> keys(points.size());
+	for(size_t i = 0; i < points.size(); i++)
+		keys[i] = hilbertIndex(side, (uint32_t)((points[i].x - min_x) * scale), (uint32_t)((points[i].y - min_y) * scale));
+
+	sortedTour(keys, first_point, tour);
+}
+
+
+/*
+	Boustrophedon scan: the rows go from the top, even rows left to right and odd rows
+	right to left. Empty rows and cells are skipped because only the points are sorted.
+	With dots sampled on a lattice, row_height is the step of the lattice (one row of
+	dots per row); without it the rows are about sqrt(2 * area / n) high.
+*/
+void serpentineTour(const vector<Point2D>& points, int first_point, vector<int>& tour, float row_height)
+{
+	tour.clear();
+	if(points.empty())
+		return;
+	checkPoints(points, first_point);
+
+	float min_x = points[0].x, min_y = points[0].y, max_x = min_x, max_y = min_y;
+	for(size_t i = 1; i < points.size(); i++)
+	{
+		min_x = min(min_x, points[i].x);
+		min_y = min(min_y, points[i].y);
+		max_x = max(max_x, points[i].x);
+		max_y = max(max_y, points[i].y);
+	}
+
+	if(row_height <= 0)
+	{
+		float width = max(max_x - min_x, 1.0f);
+		float height = max(max_y - min_y, 1.0f);
+		row_height = sqrt(2 * width * height / points.size());
+	}
+
+	// key: the row, then the position in the row (mirrored on odd rows)
+	vector<uint64_t> keys(points.size());
+	for(size_t i = 0; i < points.size(); i++)
+	{
+		// the points of a lattice row (up to half a step off) fall in the same row
+		uint64_t row = (uint64_t)((points[i].y - min_y) / row_height + 0.5f);
+		uint64_t column = (uint64_t)((double)(points[i].x - min_x) * 1024);
+		if(row % 2 == 1)
+			column = ((uint64_t)((double)(max_x - min_x) * 1024)) - column;
+		keys[i] = (row << 40) | column;
+	}
+
+	sortedTour(keys, first_point, tour);
+}
+
+
+// root of the fragment of a point (union-find with path halving)
+static int findFragment(vector<int>& parent, int point)
+{
+	while(parent[point] != point)
+	{
+		parent[point] = parent[parent[point]];
+		point = parent[point];
+	}
+	return point;
+}
+
+
+/*
+	Greedy matching: the candidate edges (each point with its k nearest points) are
+	added from the shortest when both their points have less than two edges and they
+	don't close a cycle (union-find), so the edges make paths (fragments).
+	The fragments are joined like a nearest neighbour tour over their ends: from the
+	end of a fragment to the nearest end of a fragment not visited yet.
+	O(n k log(n k)) for the sort of the edges.
+*/
+void greedyTour(const vector<Point2D>& points, int first_point, vector<int>& tour, int k)
+{
+	tour.clear();
+	if(points.empty())
+		return;
+	checkPoints(points, first_point);
+
+	int amount_points = points.size();
+	k = max(1, min(k, amount_points - 1));
+
+	// candidate edges, sorted by length (ties by points, so the tour doesn't depend on the sort)
+	vector<int> neighbours;
+	if(amount_points > 1)
+	{
+		SpatialGrid grid(points);
+		grid.neighbourLists(k, neighbours);
+	}
+
+	struct Edge
+	{
+		double length; // squared length
+		int a, b;
+		bool operator<(const Edge& other) const
+		{
+			if(length != other.length)
+				return length < other.length;
+			return a < other.a || (a == other.a && b < other.b);
+		}
+	};
+	vector<Edge> edges;
+	edges.reserve(neighbours.size());
+	for(size_t i = 0; i < neighbours.size(); i++)
+	{
+		int a = i / k, b = neighbours[i];
+		if(b == -1)
+			continue;
+
+		// an edge in both the lists only once
+		if(b < a && find(neighbours.begin() + b * k, neighbours.begin() + (b + 1) * k, a) != neighbours.begin() + (b + 1) * k)
+			continue;
+		double dx = (double)points[a].x - points[b].x;
+		double dy = (double)points[a].y - points[b].y;
+		edges.push_back({dx * dx + dy * dy, min(a, b), max(a, b)});
+	}
+	sort(edges.begin(), edges.end());
+
+	// the edges of each point (-1 for none)
+	vector<int> links(2 * amount_points, -1);
+	vector<int> parent(amount_points);
+	for(int i = 0; i < amount_points; i++)
+		parent[i] = i;
+
+	for(size_t i = 0; i < edges.size(); i++)
+	{
+		int a = edges[i].a, b = edges[i].b;
+		if(links[2 * a + 1] != -1 || links[2 * b + 1] != -1) // a point with two edges
+			continue;
+
+		int fragment_a = findFragment(parent, a), fragment_b = findFragment(parent, b);
+		if(fragment_a == fragment_b) // a cycle (or the same edge twice)
+			continue;
+
+		parent[fragment_a] = fragment_b;
+		links[2 * a + (links[2 * a] != -1)] = b;
+		links[2 * b + (links[2 * b] != -1)] = a;
+	}
+
+	// the ends of the fragments (the points with less than two edges) in a grid
+	vector<Point2D> end_points;
+	vector<int> ends; // point of each end
+	vector<int> end_index(amount_points, -1); // index of each end in ends
+	for(int i = 0; i < amount_points; i++)
+	{
+		if(links[2 * i + 1] == -1)
+		{
+			end_index[i] = ends.size();
+			ends.push_back(i);
+			end_points.push_back(points[i]);
+		}
+	}
+	SpatialGrid end_grid(end_points);
+
+	// nearest neighbour tour over the fragments, from the fragment of first_point
+	tour.reserve(amount_points);
+	int start = first_point, previous = -1;
+	while(end_index[start] == -1) // first_point is inside its fragment: starts from one of its ends
+	{
+		int next = (links[2 * start] != previous) ? links[2 * start] : links[2 * start + 1];
+		previous = start;
+		start = next;
+	}
+
+	while(start != -1)
+	{
+		// walks the fragment
+		int current = start;
+		previous = -1;
+		end_grid.remove(end_index[start]);
+		while(current != -1)
+		{
+			tour.push_back(current);
+			int next = (links[2 * current] != previous) ? links[2 * current] : links[2 * current + 1];
+			previous = current;
+			current = next;
+		}
+		end_grid.remove(end_index[previous]);
+
+		int nearest = end_grid.nearestPoint(points[previous].x, points[previous].y);
+		start = (nearest == -1) ? -1 : ends[nearest];
+	}
+
+	rotate(tour.begin(), find(tour.begin(), tour.end(), first_point), tour.end());
+}
+
+
+void constructTour(int construction, const vector<Point2D>& points, int first_point, vector<int>& tour, float row_height)
+{
+	if(construction == NEAREST_NEIGHBOUR_TOUR)
+		nearestNeighbourTour(points, first_point, tour);
+	else if(construction == HILBERT_TOUR)
+		hilbertTour(points, first_point, tour);
+	else if(construction == SERPENTINE_TOUR)
+		serpentineTour(points, first_point, tour, row_height);
+	else if(construction == GREEDY_TOUR)
+		greedyTour(points, first_point, tour);
+	else
+	{
+		cout << "Error: unknown construction\n";
+		exit(1);
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef CONSTRUCTION_H
+#define CONSTRUCTION_H
+
+#include <vector>
+#include "tsp.h" // Point2D
+
+
+/*
+	Construction heuristics: they build a tour of a set of points from scratch, as
+	a permutation of the indexes of the points that starts from first_point.
+	They are fast but not short, the tours are seeds of LocalSearch or LinKernighan.
+
+	hilbertTour and serpentineTour only sort the points (O(n log n), no distances), the
+	tour is the order of the sort rotated to start from first_point. greedyTour and
+	nearestNeighbourTour use a SpatialGrid, they are slower but shorter.
+*/
+
+// nearest neighbour: from the first point, always to the nearest point not visited yet (duplicates included)
+void nearestNeighbourTour(const std::vector<Point2D>& points, int first_point, std::vector<int>& tour);
+
+// Hilbert curve: the points in the order of a Hilbert curve over their bounding box
+void hilbertTour(const std::vector<Point2D>& points, int first_point, std::vector<int>& tour);
+
+// serpentine: rows of row_height (0 to guess it from the density), left to right and back
+void serpentineTour(const std::vector<Point2D>& points, int first_point, std::vector<int>& tour, float row_height = 0);
+
+// greedy edge: the shortest candidate edges (k nearest points) that keep a path, fragments joined by nearest neighbour
+void greedyTour(const std::vector<Point2D>& points, int first_point, std::vector<int>& tour, int k = 6);
+
+// the constructions, to choose one with a parameter
+enum Construction
+{
+	NEAREST_NEIGHBOUR_TOUR = 0,
+	HILBERT_TOUR = 1,
+	SERPENTINE_TOUR = 2,
+	GREEDY_TOUR = 3
+};
+
+// builds a tour with one of the constructions (row_height only for SERPENTINE_TOUR)
+void constructTour(int construction, const std::vector<Point2D>& points, int first_point, std::vector<int>& tour, float row_height = 0);
+
+#endif
@@ -0,0 +1,323 @@
+#include <iostream>
+#include "lin_kernighan.h"
+using namespace std;
+
+
+// gains smaller than this are rounding errors
+static const double MIN_GAIN = 1e-7;
+
+// seconds between two tours given to the callback of solve during the kicks
+static const double OFFER_INTERVAL = 0.1;
+
+
+template<typename Metric>
+BasicLinKernighan<Metric>::BasicLinKernighan(const vector<Point2D>& points, const LinKernighanOptions& options, const Metric& metric) // constructor of BasicLinKernighan
+	: BasicLocalSearch<Metric>(points, options, metric), random(options.seed)
+{
+	if(options.max_depth < 1) // checks if a chain can't have moves
+	{
+		cout << "Error: max_depth < 1\n";
+		exit(1);
+	}
+	else if(options.breadth < 1)
+	{
+		cout << "Error: breadth < 1\n";
+		exit(1);
+	}
+	else if(options.max_kicks < 0)
+	{
+		cout << "Error: max_kicks < 0\n";
+		exit(1);
+	}
+
+	this->max_depth = options.max_depth;
+	this->breadth = options.breadth;
+	this->kick_segment = max(1, options.kick_segment);
+	this->max_kicks = options.max_kicks;
+	this->use_lin_kernighan = true;
+}
+
+
+/*
+	Finds the next moves of a chain whose free end is t2 and whose edge (t1, t2) closes
+	the tour: t3 is a candidate of t2 and t4 the neighbour of t3 on the same side that
+	t1 is of t2, so the 2-opt move (t2, t1, t3, t4) links t2 to t3 and t1 to t4.
+	gain is the length removed minus the length added by the chain (without the edge
+	that closes the tour), it must stay positive.
+	steps receives the (t3, t4) of the amount best moves, the longest (t3, t4) minus
+	(t2, t3) first. An edge added by the chain is never removed.
+*/
+template<typename Metric>
+void BasicLinKernighan<Metric>::bestSteps(int t1, int t2, double gain, int amount, vector<int>& steps)
+{
+	vector<double> scores;
+	steps.clear();
+	if(t2 == dummy) // the chain ends at the end of an open path
+		return;
+	bool forward = (t1 == next(t2));
+
+	// the dummy is a candidate of every point: it moves the end of an open path
+	for(int c = (dummy == -1) ? 0 : -1; c < k; c++)
+	{
+		int t3 = (c == -1) ? dummy : neighbours[t2 * k + c];
+		if(t3 == -1)
+			break;
+
+		double d23 = distance(t2, t3);
+		if(gain - d23 <= MIN_GAIN) // the candidates are sorted: no gain from here
+			break;
+
+		int t4 = forward ? next(t3) : prev(t3);
+		if(t3 == t1 || t4 == t2 || t4 == t1 || isFixed(t3, t4))
+			continue;
+
+		// (t3, t4) must not be an edge added by the chain
+		bool added = false;
+		for(size_t i = 0; i < chain.size() && !added; i += 4)
+			added = (chain[i] == t3 && chain[i + 2] == t4) || (chain[i] == t4 && chain[i + 2] == t3);
+		if(added)
+			continue;
+
+		// insertion in the sorted list (amount is small)
+		double score = distance(t3, t4) - d23;
+		if((int)scores.size() == amount && score <= scores.back())
+			continue;
+		if((int)scores.size() < amount)
+		{
+			scores.push_back(score);
+			steps.push_back(0);
+			steps.push_back(0);
+		}
+		int j = scores.size() - 1;
+		while(j > 0 && scores[j - 1] < score)
+		{
+			scores[j] = scores[j - 1];
+			steps[2 * j] = steps[2 * j - 2];
+			steps[2 * j + 1] = steps[2 * j - 1];
+			j--;
+		}
+		scores[j] = score;
+		steps[2 * j] = t3;
+		steps[2 * j + 1] = t4;
+	}
+}
+
+
+/*
+	Applies the chain that starts with the 2-opt move (t2, t1, t3, t4) and keeps its
+	moves up to the shortest tour. Returns false (and undoes the chain) if the tour
+	isn't shorter.
+*/
+template<typename Metric>
+bool BasicLinKernighan<Metric>::runChain(int t1, int t2, int t3, int t4)
+{
+	double gain = distance(t1, t2);
+	double best_length = current_length;
+	int best_depth = 0;
+
+	chain.clear();
+	for(int depth = 1; depth <= max_depth; depth++)
+	{
+		gain += distance(t3, t4) - distance(t2, t3);
+		makeTwoOptMove(t2, t1, t3, t4);
+		chain.push_back(t2);
+		chain.push_back(t1);
+		chain.push_back(t3);
+		chain.push_back(t4);
+
+		if(current_length < best_length - MIN_GAIN)
+		{
+			best_length = current_length;
+			best_depth = depth;
+		}
+
+		// t4 is the new free end
+		t2 = t4;
+		if(depth == max_depth || isFixed(t1, t2))
+			break;
+		bestSteps(t1, t2, gain, 1, next_steps);
+		if(next_steps.empty())
+			break;
+		t3 = next_steps[0];
+		t4 = next_steps[1];
+	}
+
+	// undoes the moves after the shortest tour, the last first
+	while((int)chain.size() > 4 * best_depth)
+	{
+		int i = chain.size() - 4;
+		makeTwoOptMove(chain[i], chain[i + 2], chain[i + 1], chain[i + 3]);
+		chain.resize(i);
+	}
+
+	for(size_t i = 0; i < chain.size(); i++)
+		activate(chain[i]);
+	return best_depth > 0;
+}
+
+
+// tries the breadth best first moves from both the edges of t1
+template<typename Metric>
+bool BasicLinKernighan<Metric>::improveLinKernighan(int t1)
+{
+	for(int direction = 0; direction < 2; direction++)
+	{
+		int t2 = (direction == 0) ? next(t1) : prev(t1);
+		if(isFixed(t1, t2))
+			continue;
+
+		chain.clear();
+		bestSteps(t1, t2, distance(t1, t2), breadth, first_steps);
+		for(size_t i = 0; i < first_steps.size(); i += 2)
+		{
+			if(runChain(t1, t2, first_steps[i], first_steps[i + 1]))
+				return true;
+		}
+	}
+	return false;
+}
+
+
+template<typename Metric>
+bool BasicLinKernighan<Metric>::improve(int vertex, LocalSearchReport& report)
+{
+	if(use_lin_kernighan && improveLinKernighan(vertex))
+		report.lk_moves++;
+	else if(improveTwoOpt(vertex))
+		report.two_opt_moves++;
+	else if(improveOrOpt(vertex))
+		report.or_opt_moves++;
+	else
+		return false;
+	return true;
+}
+
+
+// moves a segment of 1 to kick_segment points from a random point next to a candidate of one of its ends
+template<typename Metric>
+void BasicLinKernighan<Metric>::kick()
+{
+	int size_segment = min(1 + random.uniform(kick_segment), size_tour - 4);
+	if(size_segment < 1)
+		return;
+
+	// a few attempts, some segments can't be moved (the dummy, the first point of an open path)
+	for(int attempt = 0; attempt < 10; attempt++)
+	{
+		int a = random.uniform(amount_points);
+		int b = a;
+		bool has_dummy = false;
+		for(int i = 1; i < size_segment; i++)
+		{
+			b = next(b);
+			has_dummy = has_dummy || (b == dummy);
+		}
+
+		int before = prev(a);
+		int after = next(b);
+		if(has_dummy || isFixed(before, a) || isFixed(b, after))
+			continue;
+
+		int c = neighbours[((random.uniform(2) == 0) ? a : b) * k + random.uniform(k)];
+		if(c == -1)
+			continue;
+
+		// x must be outside the segment and the segment isn't moved next to before or after
+		int x = c;
+		int y = next(c);
+		int offset = (position[x] - position[a] + size_tour) % size_tour;
+		if(offset < size_segment || x == before || x == after || y == before || isFixed(x, y))
+			continue;
+
+		moveSegment(before, a, b, after, x, y, random.uniform(2) == 0);
+
+		activate(before);
+		activate(after);
+		activate(a);
+		activate(b);
+		activate(x);
+		activate(y);
+		return;
+	}
+}
+
+
+/*
+	Improves the tour with 2-opt and Or-opt moves, then with LK moves too to a local optimum,
+	then kicks it until the time limit (or max_kicks kicks) keeping the shortest tour.
+	Without time limit and max_kicks there are no kicks. The tour is changed in place.
+*/
+template<typename Metric>
+LocalSearchReport BasicLinKernighan<Metric>::solve(vector<int>& tour, const function<void(const vector<int>&, double)>& improved)
+{
+	LocalSearchReport report;
+	use_two_opt = true;
+	use_or_opt = true;
+
+	loadTour(tour);
+	startReport(report);
+
+	// the two passes, each one from every point
+	double offered_length = current_length;
+	bool in_time = true;
+	for(int pass = 0; pass < 2 && in_time; pass++)
+	{
+		use_lin_kernighan = (pass == 1);
+		for(int i = 0; i < amount_points; i++)
+			activate(order[i]);
+		in_time = runQueue(report);
+
+		if(improved && current_length < offered_length - MIN_GAIN)
+		{
+			storeTour(tour);
+			improved(tour, current_length);
+			offered_length = current_length;
+		}
+	}
+	use_lin_kernighan = true;
+
+	// kicks, each one with the local search around it (the moves are undone if it's worse)
+	double best_length = current_length;
+	chrono::steady_clock::time_point offer_time = chrono::steady_clock::now();
+	keep_journal = true;
+	while(in_time && (max_kicks > 0 ? report.kicks < max_kicks : time_limit > 0) && size_tour > 4)
+	{
+		if(timeIsOver())
+		{
+			report.timed_out = true;
+			break;
+		}
+
+		journal.clear();
+		kick();
+		report.kicks++;
+		in_time = runQueue(report);
+
+		if(current_length < best_length - MIN_GAIN)
+			best_length = current_length;
+		else if(current_length > best_length + MIN_GAIN)
+			undoJournal();
+
+		if(improved && best_length < offered_length - MIN_GAIN
+			&& chrono::duration<double>(chrono::steady_clock::now() - offer_time).count() > OFFER_INTERVAL)
+		{
+			storeTour(tour);
+			improved(tour, best_length);
+			offered_length = best_length;
+			offer_time = chrono::steady_clock::now();
+		}
+	}
+	keep_journal = false;
+	journal.clear();
+
+	finishReport(report);
+	storeTour(tour);
+	return report;
+}
+
+
+// the engines of the metrics of metric.h
+template class BasicLinKernighan<EuclideanMetric>;
+template class BasicLinKernighan<ManhattanMetric>;
+template class BasicLinKernighan<ChebyshevMetric>;
+template class BasicLinKernighan<MachineTimeMetric>;
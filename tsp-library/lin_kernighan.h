@@ -0,0 +1,79 @@
+#ifndef LIN_KERNIGHAN_H
+#define LIN_KERNIGHAN_H
+
+#include <vector>
+#include <functional>
+#include "tsp.h" // Random
+#include "local_search.h"
+
+
+// parameters of the Lin-Kernighan solver (the time limit is 1 second by default)
+struct LinKernighanOptions : public LocalSearchOptions
+{
+	int max_depth; // 2-opt moves of a chain
+	int breadth; // first moves of a chain tried from each edge
+	int kick_segment; // longest segment moved by a kick
+	int max_kicks; // kicks of a search, 0 for kicks until the time limit
+	uint64_t seed; // seed of the kicks
+	LinKernighanOptions() : max_depth(8), breadth(3), kick_segment(8), max_kicks(0), seed(0) { time_limit = 1.0; }
+};
+
+
+/*
+	Lin-Kernighan style solver: a variable depth search built on the tour of LocalSearch.
+
+	A LK move removes an edge (t1, t2) and then applies a chain of 2-opt moves: each one
+	links the free end t2 to a candidate t3 and removes an edge (t3, t4) of it, then t4 is
+	the new free end. The chain goes on while the removed edges are longer than the added
+	ones (without the edge that closes the tour) and stops at max_depth, then only the
+	part of the chain up to the shortest tour is kept. The first move of a chain tries
+	the breadth best candidates, the next ones only the best.
+
+	The search starts with a pass of 2-opt and Or-opt moves only (cheap, it gives a good
+	tour soon on big instances), then the LK moves are added. When no LK or Or-opt move
+	improves the tour, a kick moves a random segment near a
+	random point (an Or-opt move that isn't improving) and the local search runs again
+	only around the kick: if the tour isn't shorter the kick and its moves are undone.
+	The kicks go on until the time limit (or max_kicks). solve can give the better tours
+	to a callback on the way: after each pass and after the improving kicks (at most
+	every OFFER_INTERVAL seconds, copying the tour is O(n)).
+	LinKernighan is the euclidean one, see BasicLocalSearch for the metric.
+*/
+template<typename Metric>
+class BasicLinKernighan : public BasicLocalSearch<Metric>
+{
+private:
+	// members of the base template (not found without this-> in a template)
+	typedef BasicLocalSearch<Metric> Base;
+	using Base::amount_points; using Base::k; using Base::time_limit; using Base::neighbours;
+	using Base::size_tour; using Base::dummy; using Base::order; using Base::position;
+	using Base::current_length; using Base::use_two_opt; using Base::use_or_opt;
+	using Base::keep_journal; using Base::journal;
+	using Base::distance; using Base::next; using Base::prev; using Base::isFixed;
+	using Base::loadTour; using Base::storeTour; using Base::activate; using Base::makeTwoOptMove;
+	using Base::improveTwoOpt; using Base::undoJournal; using Base::moveSegment; using Base::improveOrOpt;
+	using Base::timeIsOver; using Base::runQueue; using Base::startReport; using Base::finishReport;
+private:
+	int max_depth; // 2-opt moves of a chain
+	int breadth; // first moves of a chain tried from each edge
+	int kick_segment; // longest segment moved by a kick
+	int max_kicks; // kicks of a search, 0 for kicks until the time limit
+	bool use_lin_kernighan; // false during the first pass (2-opt and Or-opt moves only)
+	Random random; // chooses the kicks
+	std::vector<int> chain; // 2-opt moves of the current chain (t1, t2, t3, t4 of each move)
+	std::vector<int> first_steps, next_steps; // candidate moves of a chain (t3, t4 of each move)
+private:
+	void bestSteps(int t1, int t2, double gain, int amount, std::vector<int>& steps); // best next moves of a chain
+	bool runChain(int t1, int t2, int t3, int t4); // applies a chain, false if it doesn't improve
+	bool improveLinKernighan(int t1); // applies an improving LK move that starts from t1
+	bool improve(int vertex, LocalSearchReport& report); // applies an improving move around a vertex
+	void kick(); // moves a random segment
+public:
+	BasicLinKernighan(const std::vector<Point2D>& points, const LinKernighanOptions& options = LinKernighanOptions(), const Metric& metric = Metric()); // constructor
+	LocalSearchReport solve(std::vector<int>& tour, const std::function<void(const std::vector<int>&, double)>& improved = NULL); // improves a tour until the time limit, improved (if any) receives the better tours and their lengths
+};
+
+
+typedef BasicLinKernighan<EuclideanMetric> LinKernighan;
+
+#endif
@@ -0,0 +1,544 @@
+#include <iostream>
+#include <chrono>
+#include "local_search.h"
+using namespace std;
+
+
+// gains smaller than this are rounding errors
+static const double MIN_GAIN = 1e-7;
+
+
+template<typename Metric>
+BasicLocalSearch<Metric>::BasicLocalSearch(const vector<Point2D>& points, const LocalSearchOptions& options, const Metric& metric) // constructor of BasicLocalSearch
+	: grid(points), metric(metric)
+{
+	if(options.neighbours < 1) // checks if there are no candidates
+	{
+		cout << "Error: neighbours < 1\n";
+		exit(1);
+	}
+	else if(options.max_segment < 1)
+	{
+		cout << "Error: max_segment < 1\n";
+		exit(1);
+	}
+
+	this->amount_points = points.size();
+	this->k = options.neighbours;
+	this->max_segment = options.max_segment;
+	this->time_limit = options.time_limit;
+	this->closed_tour = options.closed_tour;
+	this->size_tour = closed_tour ? amount_points : amount_points + 1;
+	this->dummy = closed_tour ? -1 : amount_points;
+	this->first_point = -1;
+	this->searched_end = -1;
+	this->current_length = 0;
+	this->use_two_opt = true;
+	this->use_or_opt = true;
+	this->keep_journal = false;
+
+	grid.neighbourLists(k, neighbours);
+	sortNeighbours();
+
+	order.resize(size_tour);
+	position.resize(size_tour);
+	is_active.assign(size_tour, false);
+}
+
+
+/*
+	The grid gives the k nearest points sorted by euclidean distance, the moves stop at
+	the first candidate that is too far: with another metric the lists must be sorted
+	again (insertion sort: the lists are short and almost sorted).
+*/
+template<typename Metric>
+void BasicLocalSearch<Metric>::sortNeighbours()
+{
+	for(int point = 0; point < amount_points; point++)
+	{
+		int* list = &neighbours[point * k];
+		for(int i = 1; i < k && list[i] != -1; i++)
+		{
+			int candidate = list[i];
+			double d = distance(point, candidate);
+			int j = i;
+			for(; j > 0 && distance(point, list[j - 1]) > d; j--)
+				list[j] = list[j - 1];
+			list[j] = candidate;
+		}
+	}
+}
+
+
+// the edge between the dummy and the first point keeps the start of an open path
+template<typename Metric>
+bool BasicLocalSearch<Metric>::isFixed(int a, int b) const
+{
+	return (a == dummy && b == first_point) || (a == first_point && b == dummy);
+}
+
+
+template<typename Metric>
+void BasicLocalSearch<Metric>::loadTour(const vector<int>& tour)
+{
+	if((int)tour.size() != amount_points) // checks if the tour has all the points
+	{
+		cout << "Error: the tour must have " << amount_points << " points\n";
+		exit(1);
+	}
+
+	for(int i = 0; i < amount_points; i++)
+		order[i] = tour[i];
+	if(!closed_tour)
+		order[amount_points] = dummy;
+
+	for(int i = 0; i < size_tour; i++)
+		position[order[i]] = i;
+	first_point = tour[0];
+	searched_end = -1;
+	current_length = length();
+}
+
+
+// writes the tour from the first point, in the direction that leaves the dummy at the end
+template<typename Metric>
+void BasicLocalSearch<Metric>::storeTour(vector<int>& tour) const
+{
+	bool backwards = closed_tour ? false : (next(first_point) == dummy);
+
+	tour.clear();
+	int vertex = first_point;
+	for(int i = 0; i < amount_points; i++)
+	{
+		tour.push_back(vertex);
+		vertex = backwards ? prev(vertex) : next(vertex);
+	}
+}
+
+
+template<typename Metric>
+double BasicLocalSearch<Metric>::length() const
+{
+	double total = 0;
+	for(int i = 0; i < size_tour; i++)
+		total += distance(order[i], order[(i + 1) % size_tour]);
+	return total;
+}
+
+
+template<typename Metric>
+double BasicLocalSearch<Metric>::tourLength(const vector<int>& tour) const
+{
+	double total = 0;
+	for(size_t i = 0; i + 1 < tour.size(); i++)
+		total += distance(tour[i], tour[i + 1]);
+	if(closed_tour && tour.size() > 1)
+		total += distance(tour.back(), tour[0]);
+	return total;
+}
+
+
+template<typename Metric>
+void BasicLocalSearch<Metric>::activate(int vertex)
+{
+	if(vertex == dummy || is_active[vertex])
+		return;
+	is_active[vertex] = true;
+	active.push_back(vertex);
+}
+
+
+/*
+	Reverses the path from "from" to "to", or the rest of the tour if it's shorter:
+	in a symmetric tour both give the same edges, but the direction of the tour
+	is reversed in the second case.
+*/
+template<typename Metric>
+void BasicLocalSearch<Metric>::reverse(int from, int to)
+{
+	int i = position[from];
+	int j = position[to];
+	int size_path = (j - i + size_tour) % size_tour + 1;
+
+	if(2 * size_path > size_tour)
+	{
+		i = (position[to] + 1) % size_tour;
+		j = (position[from] + size_tour - 1) % size_tour;
+		size_path = size_tour - size_path;
+	}
+
+	for(int swaps = size_path / 2; swaps > 0; swaps--)
+	{
+		int aux = order[i];
+		order[i] = order[j];
+		order[j] = aux;
+		position[order[i]] = i;
+		position[order[j]] = j;
+
+		i = (i + 1) % size_tour;
+		j = (j + size_tour - 1) % size_tour;
+	}
+}
+
+
+/*
+	Removes the edges (t1, t2) and (t3, t4) and adds (t1, t3) and (t2, t4):
+	t2 and t4 must be both the next or both the previous of t1 and t3.
+*/
+template<typename Metric>
+void BasicLocalSearch<Metric>::makeTwoOptMove(int t1, int t2, int t3, int t4)
+{
+	current_length += distance(t1, t3) + distance(t2, t4) - distance(t1, t2) - distance(t3, t4);
+
+	if(t2 == next(t1))
+		reverse(t2, t3);
+	else
+		reverse(t1, t4);
+
+	if(keep_journal)
+	{
+		journal.push_back(t1);
+		journal.push_back(t2);
+		journal.push_back(t3);
+		journal.push_back(t4);
+	}
+}
+
+
+// the move (t1, t2, t3, t4) is undone by the move (t1, t3, t2, t4)
+template<typename Metric>
+void BasicLocalSearch<Metric>::undoJournal()
+{
+	bool keep = keep_journal;
+	keep_journal = false;
+
+	for(int i = journal.size() - 4; i >= 0; i -= 4)
+		makeTwoOptMove(journal[i], journal[i + 2], journal[i + 1], journal[i + 3]);
+	journal.clear();
+
+	keep_journal = keep;
+}
+
+
+/*
+	2-opt move: removes the edges (t1, t2) and (t3, t4), adds (t1, t3) and (t2, t4).
+	t2 is the next or the previous of t1 and t3 is a candidate of t1 closer than t2,
+	otherwise (t1, t3) can't be shorter than (t1, t2) and the move can't improve
+	(the dummy is at distance 0, so it's always the first candidate of an open path).
+	Applies the first improving move, returns false if there's none.
+*/
+template<typename Metric>
+bool BasicLocalSearch<Metric>::improveTwoOpt(int t1)
+{
+	for(int direction = 0; direction < 2; direction++)
+	{
+		int t2 = (direction == 0) ? next(t1) : prev(t1);
+		double d12 = distance(t1, t2);
+
+		if(isFixed(t1, t2))
+			continue;
+
+		// the dummy is a candidate of every point: it moves the end of an open path
+		for(int c = (dummy == -1) ? 0 : -1; c < k; c++)
+		{
+			int t3 = (c == -1) ? dummy : neighbours[t1 * k + c];
+			if(t3 == -1)
+				break;
+
+			double d13 = distance(t1, t3);
+			if(d13 >= d12) // the candidates are sorted: no improvement from here
+				break;
+
+			int t4 = (direction == 0) ? next(t3) : prev(t3);
+			if(t3 == t2 || t4 == t1 || isFixed(t3, t4))
+				continue;
+
+			double gain = d12 + distance(t3, t4) - d13 - distance(t2, t4);
+			if(gain > MIN_GAIN)
+			{
+				makeTwoOptMove(t1, t2, t3, t4);
+
+				activate(t1);
+				activate(t2);
+				activate(t3);
+				activate(t4);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+/*
+	Moves the segment a ... b (following next, between before and after) between x and y
+	(y is the next of x): x is linked to b if x_linked_to_b, else to a.
+	The tour before a ... b after ... x y becomes before after ... x b ... a y with two
+	2-opt moves, and before after ... x a ... b y with a third one.
+*/
+template<typename Metric>
+void BasicLocalSearch<Metric>::moveSegment(int before, int a, int b, int after, int x, int y, bool x_linked_to_b)
+{
+	makeTwoOptMove(before, a, x, y);
+	makeTwoOptMove(before, x, after, b);
+	if(!x_linked_to_b)
+		makeTwoOptMove(x, b, a, y);
+}
+
+
+/*
+	Or-opt move: the segment from s1 to s2 (1 to max_segment points, following next
+	or prev from s1) leaves the tour between p and n and goes between c and d, a
+	candidate of one of its ends and a neighbour of c.
+	Applies the first improving move, returns false if there's none.
+*/
+template<typename Metric>
+bool BasicLocalSearch<Metric>::improveOrOpt(int s1)
+{
+	for(int direction = 0; direction < 2; direction++)
+	{
+		int s2 = s1;
+		for(int size_segment = 1; size_segment <= max_segment && size_segment + 2 < size_tour; size_segment++)
+		{
+			if(size_segment > 1)
+				s2 = (direction == 0) ? next(s2) : prev(s2);
+			if(s2 == dummy) // the dummy stays between the end and the start
+				break;
+
+			int p = (direction == 0) ? prev(s1) : next(s1);
+			int n = (direction == 0) ? next(s2) : prev(s2);
+			if(isFixed(p, s1) || isFixed(s2, n))
+				continue;
+
+			// what the tour saves without the segment
+			double removal_gain = distance(p, s1) + distance(s2, n) - distance(p, n);
+			if(removal_gain <= MIN_GAIN)
+				continue;
+
+			int a = (direction == 0) ? s1 : s2;
+			int b = (direction == 0) ? s2 : s1;
+			int before = (direction == 0) ? p : n;
+			int after = (direction == 0) ? n : p;
+
+			for(int end = 0; end < 2; end++)
+			{
+				int e = (end == 0) ? s1 : s2; // linked to c
+				int f = (end == 0) ? s2 : s1; // linked to d
+
+				for(int i = (dummy == -1) ? 0 : -1; i < k; i++)
+				{
+					int c = (i == -1) ? dummy : neighbours[e * k + i];
+					if(c == -1)
+						break;
+
+					double dec = distance(e, c);
+					if(dec >= removal_gain) // the candidates are sorted: no improvement from here
+						break;
+
+					// c must be outside the segment, the segment isn't moved next to p or n
+					int offset = (position[c] - position[a] + size_tour) % size_tour;
+					if(offset < size_segment || c == p || c == n)
+						continue;
+
+					for(int side = 0; side < 2; side++)
+					{
+						int d = (side == 0) ? next(c) : prev(c);
+						if(d == p || d == n || isFixed(c, d))
+							continue;
+
+						double gain = removal_gain + distance(c, d) - dec - distance(f, d);
+						if(gain <= MIN_GAIN)
+							continue;
+
+						// following next, the segment is before a ... b after and the edge is x y
+						int x = (side == 0) ? c : d;
+						int y = (side == 0) ? d : c;
+						moveSegment(before, a, b, after, x, y, (x == c) == (e == b));
+
+						activate(p);
+						activate(n);
+						activate(a);
+						activate(b);
+						activate(c);
+						activate(d);
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+
+/*
+	The end of an open path is a neighbour of every point (through the dummy), so when
+	it moves the don't-look bits of points far from it stay on: this turns them off
+	for the points that can be linked to the end with an improving move.
+	The move links the end to the neighbour t2 of the new end t1, so t2 is looked for
+	in the candidate list of the end (O(k) instead of a scan of the whole tour), and
+	only when the end moved since the last search. Returns false if there's none.
+*/
+template<typename Metric>
+bool BasicLocalSearch<Metric>::activateEnd()
+{
+	// the neighbours of the dummy are the first point and the end of the path
+	int end = (next(dummy) == first_point) ? prev(dummy) : next(dummy);
+	if(end == searched_end || end == first_point)
+		return false;
+	searched_end = end;
+
+	bool found = false;
+	for(int c = 0; c < k; c++)
+	{
+		int t2 = neighbours[end * k + c];
+		if(t2 == -1)
+			break;
+
+		for(int direction = 0; direction < 2; direction++)
+		{
+			int t1 = (direction == 0) ? prev(t2) : next(t2);
+			int t4 = (direction == 0) ? next(dummy) : prev(dummy);
+			if(t1 == dummy || t4 != end || t4 == t1 || isFixed(t1, t2))
+				continue;
+
+			if(distance(t1, t2) - distance(t2, t4) > MIN_GAIN)
+			{
+				activate(t1);
+				found = true;
+			}
+		}
+	}
+	return found;
+}
+
+
+template<typename Metric>
+bool BasicLocalSearch<Metric>::timeIsOver() const
+{
+	return time_limit > 0 && chrono::duration<double>(chrono::steady_clock::now() - begin_time).count() > time_limit;
+}
+
+
+template<typename Metric>
+bool BasicLocalSearch<Metric>::improve(int vertex, LocalSearchReport& report)
+{
+	if(use_two_opt && improveTwoOpt(vertex))
+		report.two_opt_moves++;
+	else if(use_or_opt && improveOrOpt(vertex))
+		report.or_opt_moves++;
+	else
+		return false;
+	return true;
+}
+
+
+/*
+	Applies improving moves to the active vertices until the queue is empty.
+	Returns false if the time limit is over, the vertices left in the queue
+	are searched by the next call.
+*/
+template<typename Metric>
+bool BasicLocalSearch<Metric>::runQueue(LocalSearchReport& report)
+{
+	for(int step = 1; !active.empty() || (use_two_opt && dummy != -1 && activateEnd()); step++)
+	{
+		// reading the clock is slow, it's read every 256 points
+		if(step % 256 == 0 && timeIsOver())
+		{
+			report.timed_out = true;
+			return false;
+		}
+
+		int vertex = active.front();
+		active.pop_front();
+		is_active[vertex] = false;
+
+		improve(vertex, report);
+	}
+	return true;
+}
+
+
+// the tour must be already in order
+template<typename Metric>
+void BasicLocalSearch<Metric>::startReport(LocalSearchReport& report)
+{
+	begin_time = chrono::steady_clock::now();
+	report.initial_length = current_length;
+	report.moves = 0;
+	report.two_opt_moves = 0;
+	report.or_opt_moves = 0;
+	report.lk_moves = 0;
+	report.kicks = 0;
+	report.timed_out = false;
+}
+
+
+template<typename Metric>
+void BasicLocalSearch<Metric>::finishReport(LocalSearchReport& report)
+{
+	// the points left in the queue will be searched by the next search
+	while(!active.empty())
+	{
+		is_active[active.front()] = false;
+		active.pop_front();
+	}
+
+	report.moves = report.two_opt_moves + report.or_opt_moves + report.lk_moves;
+	report.final_length = length();
+	report.seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+}
+
+
+/*
+	Applies improving moves until none of the candidates improves the tour
+	or until the time limit. The tour is changed in place.
+*/
+template<typename Metric>
+LocalSearchReport BasicLocalSearch<Metric>::search(vector<int>& tour, bool two_opt, bool or_opt)
+{
+	LocalSearchReport report;
+	use_two_opt = two_opt;
+	use_or_opt = or_opt;
+
+	loadTour(tour);
+	startReport(report);
+
+	// at the beginning every point is searched
+	for(int i = 0; i < amount_points; i++)
+		activate(order[i]);
+	runQueue(report);
+
+	finishReport(report);
+	storeTour(tour);
+	return report;
+}
+
+
+template<typename Metric>
+LocalSearchReport BasicLocalSearch<Metric>::twoOpt(vector<int>& tour)
+{
+	return search(tour, true, false);
+}
+
+
+template<typename Metric>
+LocalSearchReport BasicLocalSearch<Metric>::orOpt(vector<int>& tour)
+{
+	return search(tour, false, true);
+}
+
+
+template<typename Metric>
+LocalSearchReport BasicLocalSearch<Metric>::or2Opt(vector<int>& tour)
+{
+	return search(tour, true, true);
+}
+
+
+// the engines of the metrics of metric.h
+template class BasicLocalSearch<EuclideanMetric>;
+template class BasicLocalSearch<ManhattanMetric>;
+template class BasicLocalSearch<ChebyshevMetric>;
+template class BasicLocalSearch<MachineTimeMetric>;
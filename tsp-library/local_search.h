@@ -0,0 +1,121 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include <vector>
+#include <deque>
+#include <chrono>
+#include "tsp.h" // Point2D
+#include "spatial.h"
+#include "metric.h"
+
+
+// parameters of the local search
+struct LocalSearchOptions
+{
+	int neighbours; // candidates of each point (its k nearest points)
+	bool closed_tour; // true: the tour returns to the first point, false: open path from the first point
+	int max_segment; // longest segment moved by Or-opt
+	double time_limit; // seconds of a search, 0 for no limit
+	LocalSearchOptions() : neighbours(8), closed_tour(false), max_segment(3), time_limit(0) {}
+};
+
+
+// what a local search did
+struct LocalSearchReport
+{
+	double initial_length; // length of the tour before the search
+	double final_length; // length of the tour after the search
+	int moves; // improving moves applied
+	int two_opt_moves; // moves that reversed a path
+	int or_opt_moves; // moves that relocated a segment
+	int lk_moves; // chains of 2-opt moves (Lin-Kernighan)
+	int kicks; // random moves tried to leave a local optimum (Lin-Kernighan)
+	double seconds; // time of the search
+	bool timed_out; // true if the search stopped at the time limit
+	double improvement() const { return initial_length - final_length; }
+};
+
+
+/*
+	Improves tours of a set of points with local moves.
+
+	A tour is a permutation of the indexes of the points (like the solutions of
+	Genetic) whose first point never changes. An open path (the machine doesn't
+	go back to the first dot) is a tour with a dummy vertex at distance 0 from
+	every point, placed between the last and the first point: the edge from the
+	dummy to the first point is never removed, so the path keeps its start and
+	its end is free.
+
+	The moves only look at the k nearest points of each point (candidate lists)
+	and the points whose edges didn't change since their last failed search are
+	skipped (don't-look bits), so a pass is about O(n k) instead of O(n^2).
+	The tour is stored as an array with the position of every point, a 2-opt
+	move reverses the shorter of the two sides of the tour.
+
+	Or-opt moves a segment of 1 to max_segment points between two other points
+	(reversed or not), it's the 3-opt move that removes short detours; it's
+	applied as two or three 2-opt moves. or2Opt tries both kinds of moves.
+
+	The lengths are measured with Metric (see metric.h), LocalSearch is the euclidean one.
+*/
+template<typename Metric>
+class BasicLocalSearch
+{
+protected:
+	SpatialGrid grid; // the points
+	Metric metric; // distance between two points
+	int amount_points; // number of points (without the dummy)
+	int k; // size of the candidate lists
+	int max_segment; // longest segment moved by Or-opt
+	double time_limit; // seconds of a search, 0 for no limit
+	std::vector<int> neighbours; // candidate lists, k for each point (-1 if missing)
+	bool closed_tour; // false if there's the dummy vertex
+	int size_tour; // amount_points, plus one with the dummy
+	int dummy; // index of the dummy vertex (amount_points), -1 if closed_tour
+	int first_point; // the point that starts the tour
+	int searched_end; // end of the open path at the last activateEnd (-1 if it wasn't searched)
+	std::vector<int> order; // the tour
+	std::vector<int> position; // position of each vertex in order
+	std::deque<int> active; // vertices to search (don't-look bits off)
+	std::vector<bool> is_active; // true if the vertex is in active
+	double current_length; // length of order
+	bool use_two_opt, use_or_opt; // moves of the current search
+	std::chrono::steady_clock::time_point begin_time; // start of the current search
+	bool keep_journal; // true to record the 2-opt moves in journal
+	std::vector<int> journal; // 2-opt moves applied (t1, t2, t3, t4 of each move)
+protected:
+	double distance(int a, int b) const { return (a == dummy || b == dummy) ? 0 : metric(grid.point(a), grid.point(b)); } // distance between two vertices (0 for the dummy)
+	void sortNeighbours(); // sorts the candidate lists with the metric
+	int next(int vertex) const { return order[(position[vertex] + 1) % size_tour]; }
+	int prev(int vertex) const { return order[(position[vertex] + size_tour - 1) % size_tour]; }
+	bool isFixed(int a, int b) const; // true if the edge can't be removed
+	void loadTour(const std::vector<int>& tour); // copies a tour in order
+	void storeTour(std::vector<int>& tour) const; // copies order in a tour (from the first point)
+	double length() const; // length of order
+	void activate(int vertex); // turns off the don't-look bit of a vertex
+	void reverse(int from, int to); // reverses the path from "from" to "to" (following next)
+	void makeTwoOptMove(int t1, int t2, int t3, int t4); // replaces (t1, t2), (t3, t4) with (t1, t3), (t2, t4)
+	bool improveTwoOpt(int t1); // applies an improving 2-opt move that removes an edge of t1
+	void undoJournal(); // undoes the moves of the journal, the last first
+	void moveSegment(int before, int a, int b, int after, int x, int y, bool x_linked_to_b); // moves the segment a ... b between x and y
+	bool improveOrOpt(int s1); // applies an improving Or-opt move of a segment that starts at s1
+	bool activateEnd(); // searches again the points that can be linked to the end of an open path
+	bool timeIsOver() const; // true if the time limit of the search is over
+	virtual bool improve(int vertex, LocalSearchReport& report); // applies an improving move around a vertex
+	bool runQueue(LocalSearchReport& report); // applies moves until there's no improvement, false if it's out of time
+	void startReport(LocalSearchReport& report); // starts the search of the tour in order
+	void finishReport(LocalSearchReport& report); // completes the report at the end of the search
+	LocalSearchReport search(std::vector<int>& tour, bool two_opt, bool or_opt); // applies the moves until there's no improvement
+public:
+	BasicLocalSearch(const std::vector<Point2D>& points, const LocalSearchOptions& options = LocalSearchOptions(), const Metric& metric = Metric()); // constructor
+	virtual ~BasicLocalSearch() {} // destructor
+	LocalSearchReport twoOpt(std::vector<int>& tour); // improves a tour with 2-opt moves
+	LocalSearchReport orOpt(std::vector<int>& tour); // improves a tour moving segments
+	LocalSearchReport or2Opt(std::vector<int>& tour); // improves a tour with 2-opt and Or-opt moves
+	double tourLength(const std::vector<int>& tour) const; // length of a tour (the closing edge only with closed_tour)
+};
+
+
+typedef BasicLocalSearch<EuclideanMetric> LocalSearch;
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef METRIC_H
+#define METRIC_H
+
+#include <vector>
+#include <math.h> // sqrt, fabs
+#include "tsp.h" // Point2D
+
+
+/*
+	Metrics of the tsp engines: the engines are templates on the metric, so each one
+	gets its own kernel with the distance inlined (no virtual calls in the inner loops).
+	A metric is a small struct with
+		double operator()(const Point2D& a, const Point2D& b) const
+	that is symmetric and 0 only between equal points (not needed for a constant
+	cost of each move, see MachineTimeMetric).
+
+	The candidate lists come from the euclidean nearest points (see SpatialGrid),
+	the local search sorts them again with its metric.
+*/
+
+
+// straight line distance, the length of the drawn path
+struct EuclideanMetric
+{
+	double operator()(const Point2D& a, const Point2D& b) const
+	{
+		double dx = (double)a.x - b.x;
+		double dy = (double)a.y - b.y;
+		return sqrt(dx * dx + dy * dy);
+	}
+};
+
+
+// the axes move one after the other at the same speed
+struct ManhattanMetric
+{
+	double operator()(const Point2D& a, const Point2D& b) const
+	{
+		return fabs((double)a.x - b.x) + fabs((double)a.y - b.y);
+	}
+};
+
+
+// the axes move at the same time at the same speed
+struct ChebyshevMetric
+{
+	double operator()(const Point2D& a, const Point2D& b) const
+	{
+		double dx = fabs((double)a.x - b.x);
+		double dy = fabs((double)a.y - b.y);
+		return (dx > dy) ? dx : dy;
+	}
+};
+
+
+/*
+	Seconds of a move of the machine: the firmware moves X to the end and then Y
+	(move_x_motor, then move_y_motors), each at a constant speed, and then it stops
+	to paint the dot (delay and servo). So a move costs
+		|dx| * seconds_per_unit_x + |dy| * seconds_per_unit_y + seconds_per_dot
+	where a unit is a unit of the points (pixels of the camera in the apps).
+	seconds_per_dot is the same for every move of a tour (it changes only the
+	length, not which tour is the shortest).
+*/
+struct MachineTimeMetric
+{
+	double seconds_per_unit_x; // seconds to move X by one unit
+	double seconds_per_unit_y; // seconds to move Y by one unit
+	double seconds_per_dot; // seconds spent on each dot
+	MachineTimeMetric(double seconds_per_unit_x = 1, double seconds_per_unit_y = 1, double seconds_per_dot = 0)
+		: seconds_per_unit_x(seconds_per_unit_x), seconds_per_unit_y(seconds_per_unit_y), seconds_per_dot(seconds_per_dot) {}
+	double operator()(const Point2D& a, const Point2D& b) const
+	{
+		return fabs((double)a.x - b.x) * seconds_per_unit_x + fabs((double)a.y - b.y) * seconds_per_unit_y + seconds_per_dot;
+	}
+};
+
+
+// length of a tour of the points with a metric (the closing edge only with closed_tour), any integer type of index
+template<typename Metric, typename Index>
+double pathLength(const std::vector<Point2D>& points, const std::vector<Index>& tour, bool closed_tour, const Metric& metric)
+{
+	double length = 0;
+	for(size_t i = 0; i + 1 < tour.size(); i++)
+		length += metric(points[tour[i]], points[tour[i + 1]]);
+	if(closed_tour && tour.size() > 1)
+		length += metric(points[tour.back()], points[tour[0]]);
+	return length;
+}
+
+#endif
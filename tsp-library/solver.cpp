@@ -0,0 +1,181 @@
+#include <iostream>
+#include "solver.h"
+using namespace std;
+
+
+Deadline deadlineIn(double seconds)
+{
+	return chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+}
+
+
+double secondsLeft(const Deadline& deadline)
+{
+	return chrono::duration<double>(deadline - chrono::steady_clock::now()).count();
+}
+
+
+BestTour::BestTour() // constructor of BestTour
+{
+	length = -1;
+	version = 0;
+}
+
+
+bool BestTour::offer(const vector<int>& tour, double length)
+{
+	lock_guard<mutex> guard(lock);
+	if(this->length != -1 && length >= this->length)
+		return false;
+
+	this->tour = tour;
+	this->length = length;
+	version++;
+	return true;
+}
+
+
+bool BestTour::get(vector<int>& tour) const
+{
+	lock_guard<mutex> guard(lock);
+	if(length == -1)
+		return false;
+
+	tour = this->tour;
+	return true;
+}
+
+
+double BestTour::getLength() const
+{
+	lock_guard<mutex> guard(lock);
+	return length;
+}
+
+
+int BestTour::getVersion() const
+{
+	lock_guard<mutex> guard(lock);
+	return version;
+}
+
+
+void BestTour::clear()
+{
+	lock_guard<mutex> guard(lock);
+	tour.clear();
+	length = -1;
+	version = 0;
+}
+
+
+Solver::Solver(bool closed_tour) // constructor of Solver
+{
+	this->closed_tour = closed_tour;
+}
+
+
+double Solver::tourLength(const vector<Point2D>& points, const vector<int>& tour) const
+{
+	return pathLength(points, tour, closed_tour, EuclideanMetric());
+}
+
+
+ConstructionSolver::ConstructionSolver(int construction, float row_height, bool closed_tour) // constructor of ConstructionSolver
+	: Solver(closed_tour)
+{
+	this->construction = construction;
+	this->row_height = row_height;
+}
+
+
+void ConstructionSolver::solve(const vector<Point2D>& points, int first_point, const Deadline&, BestTour& best)
+{
+	if(points.empty())
+		return;
+
+	vector<int> tour;
+	constructTour(construction, points, first_point, tour, row_height);
+	best.offer(tour, tourLength(points, tour));
+}
+
+
+GeneticSolver::GeneticSolver(int size_population, int generations, int mutation_rate, uint64_t seed, bool closed_tour) // constructor of GeneticSolver
+	: Solver(closed_tour)
+{
+	this->size_population = size_population;
+	this->generations = generations;
+	this->mutation_rate = mutation_rate;
+	this->seed = seed;
+}
+
+
+/*
+	The solutions of Genetic are closed tours (it's the cost of the graph), by default
+	they are measured as closed tours too; with closed_tour = false the offered tours
+	are measured as open paths from first_point, like the other solvers. The nearest
+	neighbour tour is offered first: Genetic needs some generations to beat it, and
+	with less than 3 points it's the only tour, so the result is "nn+ga".
+*/
+void GeneticSolver::solve(const vector<Point2D>& points, int first_point, const Deadline& deadline, BestTour& best)
+{
+	if(points.empty())
+		return;
+
+	vector<int> tour;
+	nearestNeighbourTour(points, first_point, tour);
+	best.offer(tour, tourLength(points, tour));
+	if(points.size() < 3 || secondsLeft(deadline) <= 0)
+		return;
+
+	Graph graph(points, first_point);
+	Genetic genetic(&graph, size_population, generations, mutation_rate, false);
+	genetic.setSeed(seed);
+	genetic.runUntil(deadline, [&](const vector<int>& solution, int)
+	{
+		best.offer(solution, tourLength(points, solution));
+	});
+}
+
+
+template<typename Metric>
+BasicLinKernighanSolver<Metric>::BasicLinKernighanSolver(const LinKernighanOptions& options, int construction, float row_height, const Metric& metric) // constructor of BasicLinKernighanSolver
+	: Solver(options.closed_tour), options(options), metric(metric)
+{
+	this->construction = construction;
+	this->row_height = row_height;
+}
+
+
+template<typename Metric>
+void BasicLinKernighanSolver<Metric>::solve(const vector<Point2D>& points, int first_point, const Deadline& deadline, BestTour& best)
+{
+	if(points.empty())
+		return;
+
+	vector<int> tour;
+	constructTour(construction, points, first_point, tour, row_height);
+	best.offer(tour, pathLength(points, tour, closed_tour, metric));
+
+	// the time limit is checked between the moves, so it stops a little after it
+	double seconds = secondsLeft(deadline);
+	if(seconds <= 0)
+		return;
+
+	// the tours of the search are offered on the way, so the solver is anytime on big instances too
+	LinKernighanOptions search_options = options;
+	search_options.time_limit = seconds;
+	BasicLinKernighan<Metric> lin_kernighan(points, search_options, metric);
+	lin_kernighan.solve(tour, [&](const vector<int>& improved_tour, double)
+	{
+		best.offer(improved_tour, pathLength(points, improved_tour, closed_tour, metric));
+	});
+	best.offer(tour, pathLength(points, tour, closed_tour, metric));
+}
+
+
+// the solvers of the metrics of metric.h
+template class BasicLinKernighanSolver<EuclideanMetric>;
+template class BasicLinKernighanSolver<ManhattanMetric>;
+template class BasicLinKernighanSolver<ChebyshevMetric>;
+template class BasicLinKernighanSolver<MachineTimeMetric>;
@@ -0,0 +1,104 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include "tsp.h" // Point2D, Genetic
+#include "construction.h"
+#include "lin_kernighan.h"
+#include "metric.h"
+
+
+// the time when a solver must return
+typedef std::chrono::steady_clock::time_point Deadline;
+
+Deadline deadlineIn(double seconds); // the deadline some seconds from now
+double secondsLeft(const Deadline& deadline); // seconds until the deadline (negative after it)
+
+
+/*
+	The best tour found so far by a solver. The solver offers its tours while it runs,
+	other threads (the UI) can read the best one at any time: every method locks.
+*/
+class BestTour
+{
+private:
+	mutable std::mutex lock; // protects the members below
+	std::vector<int> tour; // the best tour
+	double length; // its length, -1 if there's no tour yet
+	int version; // number of tours kept, to find out if there's a new one
+public:
+	BestTour(); // constructor
+	bool offer(const std::vector<int>& tour, double length); // keeps the tour if it's the shortest, true if kept
+	bool get(std::vector<int>& tour) const; // copies the best tour, false if there's none
+	double getLength() const; // length of the best tour, -1 if there's none
+	int getVersion() const; // 0 if there's no tour, then +1 for each new best tour
+	void clear(); // forgets the tour
+};
+
+
+/*
+	Common interface of the TSP engines: solve builds tours of the points from
+	first_point, offers the ones it finds to best and returns by the deadline
+	(a step that can't be interrupted, like a construction, can pass it by its own time).
+	The lengths are measured on the points, as open paths unless closed_tour
+	(euclidean, BasicLinKernighanSolver measures them with its metric).
+*/
+class Solver
+{
+protected:
+	bool closed_tour; // true if the tours go back to the first point
+protected:
+	double tourLength(const std::vector<Point2D>& points, const std::vector<int>& tour) const; // length of a tour
+public:
+	Solver(bool closed_tour = false); // constructor
+	virtual ~Solver() {} // destructor
+	virtual void solve(const std::vector<Point2D>& points, int first_point, const Deadline& deadline, BestTour& best) = 0; // offers tours to best until the deadline
+};
+
+
+// nearest neighbour (or another construction of construction.h): a single tour
+class ConstructionSolver : public Solver
+{
+private:
+	int construction; // NEAREST_NEIGHBOUR_TOUR, HILBERT_TOUR, SERPENTINE_TOUR or GREEDY_TOUR
+	float row_height; // rows of SERPENTINE_TOUR
+public:
+	ConstructionSolver(int construction = NEAREST_NEIGHBOUR_TOUR, float row_height = 0, bool closed_tour = false); // constructor
+	void solve(const std::vector<Point2D>& points, int first_point, const Deadline& deadline, BestTour& best);
+};
+
+
+// Genetic on the geometric graph of the points, it offers the best solution after each improving generation
+class GeneticSolver : public Solver
+{
+private:
+	int size_population; // size of the population
+	int generations; // most generations (the deadline can stop it before)
+	int mutation_rate; // mutation rate
+	uint64_t seed; // seed of the random numbers
+public:
+	GeneticSolver(int size_population = 20, int generations = 1000000, int mutation_rate = 30, uint64_t seed = 0, bool closed_tour = true); // constructor
+	void solve(const std::vector<Point2D>& points, int first_point, const Deadline& deadline, BestTour& best);
+};
+
+
+// a construction, then BasicLinKernighan until the deadline (offering its tours on the way), both measured with Metric
+template<typename Metric>
+class BasicLinKernighanSolver : public Solver
+{
+private:
+	LinKernighanOptions options; // the time limit comes from the deadline
+	int construction; // the first tour
+	float row_height; // rows of SERPENTINE_TOUR
+	Metric metric; // distance between two points
+public:
+	BasicLinKernighanSolver(const LinKernighanOptions& options = LinKernighanOptions(), int construction = GREEDY_TOUR, float row_height = 0, const Metric& metric = Metric()); // constructor
+	void solve(const std::vector<Point2D>& points, int first_point, const Deadline& deadline, BestTour& best);
+};
+
+
+typedef BasicLinKernighanSolver<EuclideanMetric> LinKernighanSolver;
+
+#endif
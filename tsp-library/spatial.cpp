@@ -0,0 +1,241 @@
+#include <iostream>
+#include <algorithm> // min, max
+#include "spatial.h"
+using namespace std;
+
+
+SpatialGrid::SpatialGrid(const vector<Point2D>& points, float points_per_cell) // constructor of SpatialGrid
+{
+	if(points.empty()) // checks if there are no points
+	{
+		cout << "Error: number of points <= 0\n";
+		exit(1);
+	}
+
+	this->points = points;
+
+	// bounding box of the points
+	min_x = points[0].x;
+	min_y = points[0].y;
+	float max_x = min_x, max_y = min_y;
+	for(size_t i = 1; i < points.size(); i++)
+	{
+		min_x = min(min_x, points[i].x);
+		min_y = min(min_y, points[i].y);
+		max_x = max(max_x, points[i].x);
+		max_y = max(max_y, points[i].y);
+	}
+
+	// cells of about points_per_cell points (the box can be a line or a point)
+	float width = max(max_x - min_x, 1.0f);
+	float height = max(max_y - min_y, 1.0f);
+	cell_size = sqrt(width * height * max(points_per_cell, 1.0f) / points.size());
+	cell_size = max(cell_size, max(width, height) / 4096.0f); // not too many cells for a line of points
+	cells_x = (int)(width / cell_size) + 1;
+	cells_y = (int)(height / cell_size) + 1;
+
+	// counting sort of the points by cell
+	cell_start.assign(cells_x * cells_y + 1, 0);
+	for(size_t i = 0; i < points.size(); i++)
+		cell_start[cellY(points[i].y) * cells_x + cellX(points[i].x) + 1]++;
+	for(size_t cell = 1; cell < cell_start.size(); cell++)
+		cell_start[cell] += cell_start[cell - 1];
+
+	vector<int> next(cell_start.begin(), cell_start.end() - 1);
+	cell_points.resize(points.size());
+	for(size_t i = 0; i < points.size(); i++)
+		cell_points[next[cellY(points[i].y) * cells_x + cellX(points[i].x)]++] = i;
+
+	// no point is removed yet
+	cell_end.assign(cell_start.begin() + 1, cell_start.end());
+	slot.resize(points.size());
+	for(size_t i = 0; i < cell_points.size(); i++)
+		slot[cell_points[i]] = i;
+	amount_left = points.size();
+}
+
+
+int SpatialGrid::cellX(float x) const
+{
+	return min(max((int)((x - min_x) / cell_size), 0), cells_x - 1);
+}
+
+
+int SpatialGrid::cellY(float y) const
+{
+	return min(max((int)((y - min_y) / cell_size), 0), cells_y - 1);
+}
+
+
+/*
+	Finds the k nearest points of a point (the point itself excluded, duplicates included)
+	sorted by distance, fewer than k if there aren't enough points.
+	The cells of the ring r are at least (r - 1) * cell_size far from the point,
+	so the search stops at the first ring that can't improve the k found.
+*/
+void SpatialGrid::nearestPoints(int point, int k, vector<int>& nearest) const
+{
+	nearest.clear();
+	if(k <= 0)
+		return;
+
+	vector<float> distances; // squared distances of nearest (same order)
+	nearest.reserve(k);
+	distances.reserve(k);
+	float x = points[point].x, y = points[point].y;
+	int cx = cellX(x), cy = cellY(y);
+	int max_ring = max(max(cx, cells_x - 1 - cx), max(cy, cells_y - 1 - cy));
+
+	for(int ring = 0; ring <= max_ring; ring++)
+	{
+		// the points of this ring can't be closer than the k found
+		if((int)nearest.size() == k)
+		{
+			float bound = (ring - 1) * cell_size;
+			if(bound > 0 && bound * bound >= distances.back())
+				break;
+		}
+
+		for(int row = cy - ring; row <= cy + ring; row++)
+		{
+			if(row < 0 || row >= cells_y)
+				continue;
+
+			// inside rows only have the two cells of the sides
+			int step = (row == cy - ring || row == cy + ring) ? 1 : max(2 * ring, 1);
+			for(int column = cx - ring; column <= cx + ring; column += step)
+			{
+				if(column < 0 || column >= cells_x)
+					continue;
+
+				int cell = row * cells_x + column;
+				for(int i = cell_start[cell]; i < cell_end[cell]; i++)
+				{
+					int other = cell_points[i];
+					if(other == point)
+						continue;
+
+					float dx = points[other].x - x;
+					float dy = points[other].y - y;
+					float distance = dx * dx + dy * dy;
+
+					if((int)nearest.size() == k && distance >= distances.back())
+						continue;
+
+					// insertion in the sorted list (k is small)
+					if((int)nearest.size() < k)
+					{
+						nearest.push_back(other);
+						distances.push_back(distance);
+					}
+					int j = nearest.size() - 1;
+					while(j > 0 && distances[j - 1] > distance)
+					{
+						nearest[j] = nearest[j - 1];
+						distances[j] = distances[j - 1];
+						j--;
+					}
+					nearest[j] = other;
+					distances[j] = distance;
+				}
+			}
+		}
+	}
+}
+
+
+/*
+	Candidate lists of the local search: neighbours[i * k + j] is the j-th nearest
+	point of the point i, -1 if the point has less than k other points
+*/
+void SpatialGrid::neighbourLists(int k, vector<int>& neighbours) const
+{
+	vector<int> nearest;
+	neighbours.assign(points.size() * k, -1);
+
+	// in the order of the cells, so the searches of consecutive points visit the same cells (cache)
+	for(size_t j = 0; j < cell_points.size(); j++)
+	{
+		int i = cell_points[j];
+		nearestPoints(i, k, nearest);
+		for(size_t j = 0; j < nearest.size(); j++)
+			neighbours[i * k + j] = nearest[j];
+	}
+}
+
+
+/*
+	Finds the nearest point to a position among the points not removed (duplicates of
+	the position included). The squared distances are compared as doubles, exact for
+	integer coordinates (the dots of the drawings), so ties don't depend on rounding.
+*/
+int SpatialGrid::nearestPoint(float x, float y) const
+{
+	if(amount_left == 0)
+		return -1;
+
+	int nearest = -1;
+	double nearest_distance = 0; // squared distance of nearest
+	int cx = cellX(x), cy = cellY(y);
+	int max_ring = max(max(cx, cells_x - 1 - cx), max(cy, cells_y - 1 - cy));
+
+	for(int ring = 0; ring <= max_ring; ring++)
+	{
+		// the points of this ring can't be closer than the one found
+		if(nearest != -1)
+		{
+			double bound = (ring - 1) * (double)cell_size;
+			if(bound > 0 && bound * bound >= nearest_distance)
+				break;
+		}
+
+		for(int row = cy - ring; row <= cy + ring; row++)
+		{
+			if(row < 0 || row >= cells_y)
+				continue;
+
+			// inside rows only have the two cells of the sides
+			int step = (row == cy - ring || row == cy + ring) ? 1 : max(2 * ring, 1);
+			for(int column = cx - ring; column <= cx + ring; column += step)
+			{
+				if(column < 0 || column >= cells_x)
+					continue;
+
+				int cell = row * cells_x + column;
+				for(int i = cell_start[cell]; i < cell_end[cell]; i++)
+				{
+					int other = cell_points[i];
+					double dx = (double)points[other].x - x;
+					double dy = (double)points[other].y - y;
+					double distance = dx * dx + dy * dy;
+
+					// the first point of the cells wins the ties
+					if(nearest == -1 || distance < nearest_distance)
+					{
+						nearest = other;
+						nearest_distance = distance;
+					}
+				}
+			}
+		}
+	}
+	return nearest;
+}
+
+
+// swaps the point with the last point left of its cell, O(1)
+void SpatialGrid::remove(int point)
+{
+	int cell = cellY(points[point].y) * cells_x + cellX(points[point].x);
+	int i = slot[point];
+	if(i >= cell_end[cell]) // already removed
+		return;
+
+	int last = cell_points[cell_end[cell] - 1];
+	cell_points[i] = last;
+	slot[last] = i;
+	cell_points[cell_end[cell] - 1] = point;
+	slot[point] = cell_end[cell] - 1;
+	cell_end[cell]--;
+	amount_left--;
+}
@@ -0,0 +1,44 @@
+#ifndef SPATIAL_H
+#define SPATIAL_H
+
+#include <vector>
+#include "tsp.h" // Point2D
+
+
+/*
+	Uniform grid over a set of points, to find the points near a position
+	without comparing it with all the points.
+
+	The cells are sized to hold about points_per_cell points each and the points
+	are sorted by cell (counting sort), so the points of a cell are contiguous.
+	A search visits the rings of cells around the position, from the inside out,
+	and stops when the next ring can't contain a closer point.
+	Points can be removed from the grid (the visited points of a construction),
+	the searches skip them.
+*/
+class SpatialGrid
+{
+private:
+	std::vector<Point2D> points; // the points
+	float min_x, min_y; // corner of the grid
+	float cell_size; // side of a cell
+	int cells_x, cells_y; // cells of each row and column
+	std::vector<int> cell_start; // first point of each cell in cell_points (one more for the end)
+	std::vector<int> cell_points; // the points sorted by cell
+	std::vector<int> cell_end; // end of the points left of each cell in cell_points
+	std::vector<int> slot; // position of each point in cell_points
+	int amount_left; // points not removed
+private:
+	int cellX(float x) const; // column of a position
+	int cellY(float y) const; // row of a position
+public:
+	SpatialGrid(const std::vector<Point2D>& points, float points_per_cell = 2.0f); // constructor
+	int size() const { return points.size(); }
+	const Point2D& point(int i) const { return points[i]; }
+	void nearestPoints(int point, int k, std::vector<int>& nearest) const; // the k nearest points of a point (the closest first)
+	void neighbourLists(int k, std::vector<int>& neighbours) const; // the k nearest points of every point, k for each point
+	int nearestPoint(float x, float y) const; // the nearest point left to a position, -1 if there are none
+	void remove(int point); // removes a point from the searches
+};
+
+#endif
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <chrono>
+#include "streaming.h"
+using namespace std;
+
+
+template<typename Metric>
+BasicStreamingTour<Metric>::BasicStreamingTour(const vector<Point2D>& points, const vector<int>& tour, int commit_ahead, const LinKernighanOptions& options, const Metric& metric) // constructor of BasicStreamingTour
+	: points(points), metric(metric), options(options)
+{
+	if(tour.size() != points.size()) // checks if the tour has all the points
+	{
+		cout << "Error: the tour isn't a tour of the points\n";
+		exit(1);
+	}
+	else if(commit_ahead < 1)
+	{
+		cout << "Error: commit_ahead < 1\n";
+		exit(1);
+	}
+	else if(options.time_limit <= 0) // a slice must end
+	{
+		cout << "Error: time_limit <= 0\n";
+		exit(1);
+	}
+
+	this->commit_ahead = commit_ahead;
+	this->options.closed_tour = false;
+	suffix_version = 0;
+	slices = 0;
+	improvements = 0;
+	stopping = false;
+
+	// the first point is committed, the suffix starts from it
+	suffix = tour;
+	if(!suffix.empty())
+	{
+		committed.push_back(suffix[0]);
+		while((int)committed.size() < commit_ahead && suffix.size() > 1)
+			commit();
+	}
+}
+
+
+template<typename Metric>
+BasicStreamingTour<Metric>::~BasicStreamingTour() // destructor of BasicStreamingTour
+{
+	stop();
+}
+
+
+// the caller holds the lock
+template<typename Metric>
+void BasicStreamingTour<Metric>::commit()
+{
+	committed.push_back(suffix[1]);
+	suffix.erase(suffix.begin());
+	suffix_version++;
+}
+
+
+template<typename Metric>
+void BasicStreamingTour<Metric>::start()
+{
+	if(worker.joinable())
+		return;
+	stopping = false;
+	worker = thread(&BasicStreamingTour::optimize, this);
+}
+
+
+template<typename Metric>
+void BasicStreamingTour<Metric>::stop()
+{
+	stopping = true;
+	if(worker.joinable())
+		worker.join();
+}
+
+
+template<typename Metric>
+int BasicStreamingTour<Metric>::next()
+{
+	lock_guard<mutex> guard(lock);
+	if(committed.empty())
+		return -1;
+
+	int point = committed.front();
+	committed.pop_front();
+
+	// keeps commit_ahead points ready
+	while((int)committed.size() < commit_ahead && suffix.size() > 1)
+		commit();
+	return point;
+}
+
+
+template<typename Metric>
+int BasicStreamingTour<Metric>::remaining() const
+{
+	lock_guard<mutex> guard(lock);
+	return committed.size() + suffix.size() - (suffix.empty() ? 0 : 1);
+}
+
+
+template<typename Metric>
+void BasicStreamingTour<Metric>::getTour(vector<int>& tour) const
+{
+	lock_guard<mutex> guard(lock);
+	tour.assign(committed.begin(), committed.end());
+	if(!suffix.empty())
+		tour.insert(tour.end(), suffix.begin() + 1, suffix.end());
+}
+
+
+template<typename Metric>
+int BasicStreamingTour<Metric>::getSlices() const
+{
+	lock_guard<mutex> guard(lock);
+	return slices;
+}
+
+
+template<typename Metric>
+int BasicStreamingTour<Metric>::getImprovements() const
+{
+	lock_guard<mutex> guard(lock);
+	return improvements;
+}
+
+
+/*
+	Each slice copies the suffix from a guard point on, improves the copy without the
+	lock (the guard point stays the first one) and puts it back if the consumer didn't
+	go past the guard point meanwhile. The points before the guard point aren't changed:
+	when the consumer is faster than a slice the guard moves further (doubling), so the
+	slices stop being thrown away.
+*/
+template<typename Metric>
+void BasicStreamingTour<Metric>::optimize()
+{
+	vector<Point2D> slice_points;
+	vector<int> slice_suffix, slice_tour;
+	int guard = 0; // first point of the suffix improved by a slice
+
+	while(!stopping)
+	{
+		int version, start;
+		{
+			lock_guard<mutex> guard_lock(lock);
+			start = min(guard, max((int)suffix.size() - 1, 0));
+			slice_suffix.assign(suffix.begin() + start, suffix.end());
+			version = suffix_version;
+		}
+
+		// nothing left to improve
+		if(slice_suffix.size() < 4)
+		{
+			this_thread::sleep_for(chrono::milliseconds(50));
+			continue;
+		}
+
+		slice_points.resize(slice_suffix.size());
+		slice_tour.resize(slice_suffix.size());
+		for(size_t i = 0; i < slice_suffix.size(); i++)
+		{
+			slice_points[i] = points[slice_suffix[i]];
+			slice_tour[i] = i;
+		}
+
+		LinKernighanOptions slice_options = options;
+		slice_options.seed = options.seed + slices;
+		BasicLinKernighan<Metric> lin_kernighan(slice_points, slice_options, metric);
+		LocalSearchReport report = lin_kernighan.solve(slice_tour);
+
+		lock_guard<mutex> guard_lock(lock);
+		slices++;
+
+		// the suffix lost its first lost points during the slice
+		int lost = suffix_version - version;
+		if(lost > start)
+		{
+			guard = max(1, 2 * guard);
+			continue;
+		}
+		if(report.final_length < report.initial_length - 1e-7)
+		{
+			int offset = start - lost;
+			for(size_t i = 0; i < slice_tour.size(); i++)
+				suffix[offset + i] = slice_suffix[slice_tour[i]];
+			improvements++;
+		}
+	}
+}
+
+
+// the streaming tours of the metrics of metric.h
+template class BasicStreamingTour<EuclideanMetric>;
+template class BasicStreamingTour<ManhattanMetric>;
+template class BasicStreamingTour<ChebyshevMetric>;
+template class BasicStreamingTour<MachineTimeMetric>;
@@ -0,0 +1,60 @@
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include "tsp.h" // Point2D
+#include "lin_kernighan.h"
+#include "metric.h"
+
+
+/*
+	Streaming tour: the machine starts from a tour while a worker thread keeps improving
+	the part of it that the machine hasn't reached yet.
+
+	The first commit_ahead points of the tour are committed: they won't change and next()
+	returns them in order. The rest (the suffix) is an open path from the last committed
+	point that the worker improves with LinKernighan, one time slice after another
+	(options.time_limit each, with a new seed for the kicks). Each call of next() commits
+	one more point from the front of the suffix, so there are always commit_ahead points
+	ready. A slice leaves alone the first points of the suffix that the consumer could
+	take meanwhile (see optimize). The slices shorten the suffix with Metric.
+*/
+template<typename Metric>
+class BasicStreamingTour
+{
+private:
+	std::vector<Point2D> points; // the points
+	Metric metric; // distance between two points
+	int commit_ahead; // points committed ahead of the consumer
+	LinKernighanOptions options; // LinKernighan of a slice (time_limit is the slice)
+	mutable std::mutex lock; // protects the members below
+	std::deque<int> committed; // points that won't change, the next one first
+	std::vector<int> suffix; // the rest of the tour, suffix[0] is the last committed point
+	int suffix_version; // +1 each time the suffix loses its first point
+	int slices; // slices of LinKernighan run by the worker
+	int improvements; // slices that shortened the suffix
+	std::thread worker; // improves the suffix
+	std::atomic<bool> stopping; // true to stop the worker
+private:
+	void commit(); // moves the first point of the suffix to committed (locked)
+	void optimize(); // loop of the worker
+public:
+	BasicStreamingTour(const std::vector<Point2D>& points, const std::vector<int>& tour, int commit_ahead = 3, const LinKernighanOptions& options = LinKernighanOptions(), const Metric& metric = Metric()); // constructor
+	~BasicStreamingTour(); // stops the worker
+	void start(); // starts the worker
+	void stop(); // stops the worker (the tour stays valid)
+	int next(); // the next point of the tour, -1 at the end
+	int remaining() const; // points not returned by next() yet
+	void getTour(std::vector<int>& tour) const; // the points not returned by next() yet, in order
+	int getSlices() const; // slices run by the worker
+	int getImprovements() const; // slices that shortened the suffix
+};
+
+
+typedef BasicStreamingTour<EuclideanMetric> StreamingTour;
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef TOUR_POINTS_H
+#define TOUR_POINTS_H
+
+#include <vector>
+#include "tsp.h" // Point2D
+#include "construction.h"
+#include "metric.h"
+
+
+/*
+	The engines work on Point2D and return tours of indexes, the apps keep their dots
+	in their own types (glm::vec2 in shortest-path-test, glm::mediump_ivec2 in
+	coherent-lines-dots, ofPoint...). These templates take any point type with x and
+	y and any integer type of index, so an app calls the engines without writing the
+	conversions again. The length of a tour is pathLength of metric.h.
+*/
+
+
+// the coordinates of points as Point2D, in the same order
+template<typename Point>
+void toPoint2D(const std::vector<Point>& points, std::vector<Point2D>& out)
+{
+	out.clear();
+	out.reserve(points.size());
+	for(size_t i = 0; i < points.size(); i++)
+		out.push_back({(float)points[i].x, (float)points[i].y});
+}
+
+
+// appends the points in the order of tour to out (a point can appear twice in points)
+template<typename Point, typename Index>
+void appendTour(const std::vector<Point>& points, const std::vector<Index>& tour, std::vector<Point>& out)
+{
+	out.reserve(out.size() + tour.size());
+	for(size_t i = 0; i < tour.size(); i++)
+		out.push_back(points[tour[i]]);
+}
+
+
+// nearest neighbour path from the first point appended to out, returns its euclidean length
+template<typename Point>
+double nearestNeighbourPath(const std::vector<Point>& points, std::vector<Point>& out)
+{
+	std::vector<Point2D> tour_points;
+	toPoint2D(points, tour_points);
+
+	std::vector<int> tour;
+	nearestNeighbourTour(tour_points, 0, tour);
+	appendTour(points, tour, out);
+	return pathLength(tour_points, tour, false, EuclideanMetric());
+}
+
+#endif
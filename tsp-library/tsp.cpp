@@ -0,0 +1,1830 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm> // sort, next_permutation
+#include "tsp.h"
+using namespace std;
+
+
+const unsigned short Graph::NO_EDGE_16;
+
+Graph::Graph(int V, int initial_vertex, bool random_graph, int storage, uint64_t seed) // constructor of Graph
+{
+	if(V < 1) // checks if number of vertexes is less than 1
+	{
+		cout << "Error: number of vertexes <= 0\n";
+		exit(1);
+	}
+	
+	this->V = V; // assigns the number of vertices
+	this->initial_vertex = initial_vertex; // assigns initial vertex
+	this->total_edges = 0; // initially the total of edges is 0
+	this->storage = storage;
+	
+	// allocates the matrix, initially there are no edges
+	size_t size_matrix = (storage & SYMMETRIC) ? (size_t)V * (V + 1) / 2 : (size_t)V * V;
+	if(storage & COMPACT)
+		compact_weights.assign(size_matrix, NO_EDGE_16);
+	else
+		weights.assign(size_matrix, -1);
+	
+	if(random_graph)
+		generatesGraph(seed);
+}
+
+
+Graph::Graph(const vector<Point2D>& points, int initial_vertex) // constructor of a geometric graph
+{
+	if(points.empty()) // checks if there are no points
+	{
+		cout << "Error: number of vertexes <= 0\n";
+		exit(1);
+	}
+	
+	this->V = points.size(); // a vertex for each point
+	this->initial_vertex = initial_vertex;
+	this->total_edges = (int64_t)V * (V - 1) / 2; // all the points are linked
+	this->storage = GEOMETRIC | SYMMETRIC;
+	this->points = points;
+}
+
+
+// keyword of a TSPLIB line ("KEY : VALUE" or a section name)
+static string tsplibKey(const string& line)
+{
+	size_t first = line.find_first_not_of(" \t");
+	if(first == string::npos)
+		return "";
+	size_t last = line.find_first_of(" \t\r:", first);
+	return line.substr(first, (last == string::npos) ? string::npos : last - first);
+}
+
+
+// value of a "KEY : VALUE" line of TSPLIB
+static string tsplibValue(const string& line)
+{
+	size_t colon = line.find(':');
+	if(colon == string::npos)
+		return "";
+	size_t first = line.find_first_not_of(" \t", colon + 1);
+	size_t last = line.find_last_not_of(" \t\r");
+	return (first == string::npos || last < first) ? "" : line.substr(first, last - first + 1);
+}
+
+
+// pseudo-euclidean distance of TSPLIB (ATT): rounded up when the rounding is lower
+static int attDistance(double dx, double dy)
+{
+	double r = sqrt((dx * dx + dy * dy) / 10.0);
+	int t = (int)(r + 0.5);
+	return (t < r) ? t + 1 : t;
+}
+
+
+Graph::Graph(const string& tsplib_file, int initial_vertex) // constructor of a TSPLIB instance
+{
+	ifstream file(tsplib_file.c_str());
+	if(!file) // checks if the file can be read
+	{
+		cout << "Error: can't open " << tsplib_file << "\n";
+		exit(1);
+	}
+	
+	string type = "TSP", weight_type, weight_format = "FULL_MATRIX", line;
+	int dimension = 0;
+	vector<int> file_weights; // EDGE_WEIGHT_SECTION, in the order of the file
+	
+	// the keywords before the sections, the sections that aren't used are skipped
+	while(getline(file, line))
+	{
+		string key = tsplibKey(line);
+		if(key == "NAME")
+			name = tsplibValue(line);
+		else if(key == "TYPE")
+			type = tsplibValue(line);
+		else if(key == "DIMENSION")
+			dimension = atoi(tsplibValue(line).c_str());
+		else if(key == "EDGE_WEIGHT_TYPE")
+			weight_type = tsplibValue(line);
+		else if(key == "EDGE_WEIGHT_FORMAT")
+			weight_format = tsplibValue(line);
+		else if(key == "NODE_COORD_SECTION")
+		{
+			points.resize(dimension);
+			for(int i = 0; i < dimension; i++)
+			{
+				int id;
+				double x, y;
+				if(!(file >> id >> x >> y) || id < 1 || id > dimension)
+				{
+					cout << "Error: bad NODE_COORD_SECTION in " << tsplib_file << "\n";
+					exit(1);
+				}
+				points[id - 1].x = x;
+				points[id - 1].y = y;
+			}
+		}
+		else if(key == "EDGE_WEIGHT_SECTION")
+		{
+			double weight;
+			size_t amount = (weight_format == "FULL_MATRIX") ? (size_t)dimension * dimension :
+				(weight_format == "UPPER_ROW" || weight_format == "LOWER_ROW") ? (size_t)dimension * (dimension - 1) / 2 :
+				(size_t)dimension * (dimension + 1) / 2;
+			while(file_weights.size() < amount && file >> weight)
+				file_weights.push_back((int)weight);
+		}
+		else if(key == "EOF")
+			break;
+	}
+	
+	if(dimension < 1) // checks if number of vertexes is less than 1
+	{
+		cout << "Error: number of vertexes <= 0\n";
+		exit(1);
+	}
+	else if(type != "TSP" && type != "ATSP")
+	{
+		cout << "Error: TSPLIB type " << type << " isn't supported\n";
+		exit(1);
+	}
+	
+	this->V = dimension;
+	this->initial_vertex = initial_vertex;
+	this->total_edges = 0;
+	
+	if(weight_type == "EUC_2D" || weight_type == "ATT")
+	{
+		if((int)points.size() != V || type != "TSP")
+		{
+			cout << "Error: " << weight_type << " needs the coordinates of a TSP\n";
+			exit(1);
+		}
+		
+		if(weight_type == "EUC_2D")
+		{
+			// the rounding of the geometric graph is the nint of TSPLIB
+			this->storage = GEOMETRIC | SYMMETRIC;
+			this->total_edges = (int64_t)V * (V - 1) / 2;
+			return;
+		}
+		
+		this->storage = SYMMETRIC;
+		weights.assign((size_t)V * (V + 1) / 2, -1);
+		for(int src = 0; src < V; src++)
+			for(int dest = src + 1; dest < V; dest++)
+				setWeight(edgeIndex(src, dest), attDistance((double)points[src].x - points[dest].x, (double)points[src].y - points[dest].y));
+		return;
+	}
+	else if(weight_type != "EXPLICIT")
+	{
+		cout << "Error: EDGE_WEIGHT_TYPE " << weight_type << " isn't supported\n";
+		exit(1);
+	}
+	
+	bool full = (weight_format == "FULL_MATRIX");
+	bool upper = (weight_format == "UPPER_ROW" || weight_format == "UPPER_DIAG_ROW");
+	bool lower = (weight_format == "LOWER_ROW" || weight_format == "LOWER_DIAG_ROW");
+	bool diagonal = (weight_format == "UPPER_DIAG_ROW" || weight_format == "LOWER_DIAG_ROW");
+	if(!full && !upper && !lower)
+	{
+		cout << "Error: EDGE_WEIGHT_FORMAT " << weight_format << " isn't supported\n";
+		exit(1);
+	}
+	else if(type == "ATSP" && !full)
+	{
+		cout << "Error: an ATSP needs a FULL_MATRIX\n";
+		exit(1);
+	}
+	
+	// a TSP keeps the upper triangle, an ATSP both directions
+	this->storage = (type == "TSP") ? SYMMETRIC : FULL;
+	size_t size_matrix = (storage & SYMMETRIC) ? (size_t)V * (V + 1) / 2 : (size_t)V * V;
+	weights.assign(size_matrix, -1);
+	
+	// the weights of the file row by row, the diagonal isn't an edge
+	size_t next = 0;
+	for(int row = 0; row < V; row++)
+	{
+		int first = full ? 0 : upper ? (diagonal ? row : row + 1) : 0;
+		int last = full ? V - 1 : upper ? V - 1 : (diagonal ? row : row - 1);
+		for(int column = first; column <= last; column++, next++)
+		{
+			if(next >= file_weights.size())
+			{
+				cout << "Error: EDGE_WEIGHT_SECTION of " << tsplib_file << " is too short\n";
+				exit(1);
+			}
+			if(row != column && (type == "ATSP" || !full || row < column))
+				setWeight(edgeIndex(row, column), file_weights[next]);
+		}
+	}
+}
+
+
+int Graph::tourCost(const vector<int>& tour) const
+{
+	int cost = 0;
+	for(size_t i = 0; tour.size() > 1 && i < tour.size(); i++)
+	{
+		int weight = existsEdge(tour[i], tour[(i + 1) % tour.size()]);
+		if(weight == -1)
+			return -1;
+		cost += weight;
+	}
+	return cost;
+}
+
+
+void writeTsplibTour(const string& tour_file, const string& name, const vector<int>& tour, int cost)
+{
+	ofstream file(tour_file.c_str());
+	if(!file)
+	{
+		cout << "Error: can't write " << tour_file << "\n";
+		exit(1);
+	}
+	
+	file << "NAME : " << name << ".tour\n";
+	if(cost != -1)
+		file << "COMMENT : Length = " << cost << "\n";
+	file << "TYPE : TOUR\n";
+	file << "DIMENSION : " << tour.size() << "\n";
+	file << "TOUR_SECTION\n";
+	for(size_t i = 0; i < tour.size(); i++)
+		file << tour[i] + 1 << "\n";
+	file << "-1\nEOF\n";
+}
+
+
+void readTsplibTour(const string& tour_file, vector<int>& tour)
+{
+	ifstream file(tour_file.c_str());
+	if(!file)
+	{
+		cout << "Error: can't open " << tour_file << "\n";
+		exit(1);
+	}
+	
+	tour.clear();
+	string line;
+	while(getline(file, line) && tsplibKey(line) != "TOUR_SECTION")
+		;
+	
+	int vertex;
+	while(file >> vertex && vertex != -1)
+		tour.push_back(vertex - 1);
+}
+
+
+void Graph::generatesGraph(uint64_t seed)
+{
+	Random random(seed);
+	vector<int> vec;
+	
+	// creates the vector
+	for(int i = 0; i < V; i++)
+		vec.push_back(i);
+	
+	// generates a random permutation
+	random.shuffle(vec.begin(), vec.end());
+	
+	initial_vertex = vec[0]; // updates initial vertex
+	
+	int i, weight;
+	for(i = 0; i <= V; i++)
+	{
+		weight = random.uniform(V) + 1; // random weight in range [1,V]
+		
+		if(i + 1 < V)
+			addEdge(vec[i], vec[i + 1], weight);
+		else
+		{
+			// add last edge
+			addEdge(vec[i], vec[0], weight);
+			break;
+		}
+	}
+	
+	int limit_edges = V * (V - 1); // calculates the limit of edges
+	int size_edges = random.uniform(2 * limit_edges) + limit_edges;
+	
+	// add others edges randomly
+	for(int i = 0; i < size_edges; i++)
+	{
+		int src = random.uniform(V); // random source
+		int dest = random.uniform(V); // random destination
+		weight = random.uniform(V) + 1; // random weight in range [1,V]
+		if(src != dest)
+		{
+			addEdge(vec[src], vec[dest], weight);
+			addEdge(vec[dest], vec[src], weight);
+		}
+	}
+}
+
+
+void Graph::showInfoGraph()
+{
+	cout << "Showing info of graph:\n\n";
+	cout << "Number of vertices: " << V;
+	cout << "\nNumber of edges: " << total_edges << "\n";
+}
+
+
+void Graph::setWeight(size_t index, int weight)
+{
+	if(storage & COMPACT)
+	{
+		if(weight >= NO_EDGE_16) // checks if the weight fits in 16 bits
+		{
+			cout << "Error: weight " << weight << " is too big for COMPACT storage\n";
+			exit(1);
+		}
+		
+		unsigned short& slot = compact_weights[index];
+		if(slot == NO_EDGE_16 && weight >= 0)
+			total_edges++;
+		else if(slot != NO_EDGE_16 && weight < 0)
+			total_edges--;
+		slot = (weight < 0) ? NO_EDGE_16 : (unsigned short)weight;
+	}
+	else
+	{
+		int& slot = weights[index];
+		if(slot < 0 && weight >= 0)
+			total_edges++;
+		else if(slot >= 0 && weight < 0)
+			total_edges--;
+		slot = (weight < 0) ? -1 : weight;
+	}
+}
+
+
+void Graph::addEdge(int src, int dest, int weight) // add a edge
+{
+	if(storage & GEOMETRIC)
+	{
+		cout << "Error: the edges of a geometric graph can't be changed\n";
+		return;
+	}
+	setWeight(edgeIndex(src, dest), weight); // adds edge in the matrix
+}
+
+
+/*
+	Loads all the weights at once, -1 means no edge.
+	The matrix can be:
+		V * V values, row-major (for SYMMETRIC storage only the upper triangle is read)
+		V * (V + 1) / 2 values, upper triangle row by row (only SYMMETRIC storage)
+*/
+void Graph::loadMatrix(const vector<int>& matrix)
+{
+	size_t size_full = (size_t)V * V;
+	size_t size_upper = (size_t)V * (V + 1) / 2;
+	
+	if(storage & GEOMETRIC)
+	{
+		cout << "Error: the edges of a geometric graph can't be changed\n";
+		return;
+	}
+	else if(matrix.size() != size_full && !((storage & SYMMETRIC) && matrix.size() == size_upper))
+	{
+		cout << "Error: matrix of " << matrix.size() << " weights doesn't match " << V << " vertices\n";
+		exit(1);
+	}
+	
+	if(matrix.size() == size_full)
+	{
+		for(int src = 0; src < V; src++)
+		{
+			// the upper triangle is enough for symmetric graphs
+			int first_dest = (storage & SYMMETRIC) ? src : 0;
+			for(int dest = first_dest; dest < V; dest++)
+				setWeight(edgeIndex(src, dest), matrix[(size_t)src * V + dest]);
+		}
+	}
+	else
+	{
+		// same layout of the symmetric storage
+		for(size_t i = 0; i < size_upper; i++)
+			setWeight(i, matrix[i]);
+	}
+}
+
+
+void Graph::showGraph() // shows all connections of the graph
+{
+	for(int src = 0; src < V; src++)
+	{
+		for(int dest = 0; dest < V; dest++)
+		{
+			int weight = existsEdge(src, dest);
+			if(weight != -1)
+				cout << src << " linked to vertex " << dest << " with weight " << weight << endl;
+		}
+	}
+}
+
+
+// constructor of Genetic
+Genetic::Genetic(Graph* graph, int size_population, int generations, int mutation_rate, bool show_population)
+{
+	if(size_population < 1) // checks if size of population is less than 1
+	{
+		cout << "Error: size_population < 1\n";
+		exit(1);
+	}
+	else if(mutation_rate < 0 || mutation_rate > 100) // checks if mutation rate is less than 0
+	{
+		cout << "Error: mutation_rate must be >= 0 and <= 100\n";
+		exit(1);
+	}
+	this->graph = graph;
+	this->size_population = size_population;
+	this->real_size_population = 0;
+	this->generations = generations;
+	this->mutation_rate = mutation_rate;
+	this->show_population = show_population;
+	this->hashes.reserve(size_population + 2); // the steady state population never grows more than 2 elements
+	
+	/* all the chromosomes live in one block of memory allocated here: the population
+		is a ranking of slots and a new member overwrites a free slot, so the
+		generations don't allocate memory */
+	int slots = size_population + 2;
+	this->compact_genes = (graph->V <= 65536);
+	if(compact_genes)
+		this->genes16.resize((size_t)slots * graph->V);
+	else
+		this->genes32.resize((size_t)slots * graph->V);
+	this->slot_costs.resize(slots);
+	this->slot_hashes.resize(slots);
+	this->ranking.reserve(slots);
+	this->merged_ranking.reserve(slots);
+	this->free_slots.reserve(slots);
+	for(int slot = slots - 1; slot >= 0; slot--)
+		this->free_slots.push_back(slot);
+	
+	// buffers of the crossover
+	this->buffers.resize(1);
+	this->buffers[0].allocate(graph->V);
+	this->children[0].genes.reserve(graph->V);
+	this->children[1].genes.reserve(graph->V);
+	
+	// steady state: each generation makes (at most) two children
+	this->children_per_generation = 0;
+	this->threads_per_generation = 1;
+	this->pool = NULL;
+	
+	// no statistics until setTelemetry is called
+	this->telemetry = NULL;
+	this->made_children = this->invalid_children = this->duplicate_children = 0;
+	
+	// same sequence until setSeed is called
+	this->random_engine.setSeed(0);
+}
+
+
+void Genetic::setSeed(uint64_t seed)
+{
+	random_engine.setSeed(seed);
+}
+
+
+// random number in the range [0, n)
+int Genetic::randomNumber(int n)
+{
+	return random_engine.uniform(n);
+}
+
+
+
+/*
+	Generational mode: each generation makes children_per_generation children with
+	the crossovers made in parallel by the threads, then the population keeps the
+	best solutions among the old ones and the new children (in one merge).
+	The random choices are drawn in order before making the children, so the results
+	don't depend on the threads.
+	children_per_generation = 0 is the steady state mode (the default).
+*/
+void Genetic::setGenerationalMode(int children_per_generation, int threads)
+{
+	this->children_per_generation = max(0, children_per_generation);
+	this->threads_per_generation = max(1, threads);
+	
+	int pairs = (this->children_per_generation + 1) / 2;
+	plans.resize(pairs);
+	batch_children.resize(pairs * 2);
+	for(size_t i = 0; i < batch_children.size(); i++)
+		batch_children[i].genes.reserve(graph->V);
+	accepted_children.reserve(batch_children.size());
+	
+	// the children of a generation are in the set of hashes until the merge
+	hashes.reserve(size_population + batch_children.size());
+	
+	buffers.resize(threads_per_generation);
+	for(size_t i = 1; i < buffers.size(); i++)
+		buffers[i].allocate(graph->V);
+}
+
+
+void HashSet::reserve(size_t amount)
+{
+	// the hashes and the tombstones are at most half of the cells
+	size_t cells = 16;
+	while(cells < 4 * amount)
+		cells *= 2;
+	if(cells <= keys.size())
+		return;
+	
+	// the hashes already in the set move to the new table
+	vector<uint64_t> old_keys;
+	old_keys.swap(keys);
+	vector<unsigned char> old_states;
+	old_states.swap(states);
+	
+	keys.assign(cells, 0);
+	states.assign(cells, EMPTY);
+	spare_keys.assign(cells, 0);
+	spare_states.assign(cells, EMPTY);
+	mask = cells - 1;
+	amount_full = amount_removed = 0;
+	
+	for(size_t i = 0; i < old_keys.size(); i++)
+		if(old_states[i] == FULL)
+			insert(old_keys[i]);
+}
+
+
+// the hashes are sums of splitmix64 values, their bits are already mixed
+size_t HashSet::findCell(uint64_t key) const
+{
+	size_t cell = (size_t)(key ^ (key >> 32)) & mask;
+	size_t free_cell = keys.size(); // first tombstone of the probe
+	
+	while(states[cell] != EMPTY)
+	{
+		if(states[cell] == FULL && keys[cell] == key)
+			return cell;
+		if(states[cell] == REMOVED && free_cell == keys.size())
+			free_cell = cell;
+		cell = (cell + 1) & mask;
+	}
+	return (free_cell == keys.size()) ? cell : free_cell;
+}
+
+
+size_t HashSet::count(uint64_t key) const
+{
+	if(keys.empty())
+		return 0;
+	
+	size_t cell = findCell(key);
+	return (states[cell] == FULL && keys[cell] == key) ? 1 : 0;
+}
+
+
+bool HashSet::insert(uint64_t key)
+{
+	// more hashes than reserved (or none reserved): the only case that allocates
+	if(4 * (amount_full + 1) > keys.size())
+		reserve(2 * (amount_full + 1));
+	
+	size_t cell = findCell(key);
+	if(states[cell] == FULL && keys[cell] == key)
+		return false;
+	
+	if(states[cell] == REMOVED)
+		amount_removed--;
+	states[cell] = FULL;
+	keys[cell] = key;
+	amount_full++;
+	
+	// a probe has to find an empty cell
+	if(2 * (amount_full + amount_removed) > keys.size())
+		rebuild();
+	return true;
+}
+
+
+void HashSet::erase(uint64_t key)
+{
+	if(keys.empty())
+		return;
+	
+	size_t cell = findCell(key);
+	if(states[cell] == FULL && keys[cell] == key)
+	{
+		states[cell] = REMOVED;
+		amount_full--;
+		amount_removed++;
+	}
+}
+
+
+void HashSet::rebuild()
+{
+	fill(spare_states.begin(), spare_states.end(), (unsigned char)EMPTY);
+	for(size_t i = 0; i < keys.size(); i++)
+	{
+		if(states[i] != FULL)
+			continue;
+		
+		size_t cell = (size_t)(keys[i] ^ (keys[i] >> 32)) & mask;
+		while(spare_states[cell] != EMPTY)
+			cell = (cell + 1) & mask;
+		spare_states[cell] = FULL;
+		spare_keys[cell] = keys[i];
+	}
+	keys.swap(spare_keys);
+	states.swap(spare_states);
+	amount_removed = 0;
+}
+
+
+void CrossoverBuffers::allocate(int V)
+{
+	visited_genes.assign(V, 0);
+	current_stamp = 0;
+	next_unused_gene.resize(V + 1);
+	prev_unused_gene.resize(V + 1);
+}
+
+
+// returns a stamp never used in visited_genes
+unsigned int CrossoverBuffers::newStamp()
+{
+	if(++current_stamp == 0) // the stamps start again, clears the old ones
+	{
+		fill(visited_genes.begin(), visited_genes.end(), 0);
+		current_stamp = 1;
+	}
+	return current_stamp;
+}
+
+
+/*
+	Checks if is a valid solution, then return total cost of path else return -1
+	
+	Repeated genes are found marking each gene with the stamp of the current check,
+	so there's nothing to allocate or clear between two checks.
+	check_genes can be false when the solution is already known to be a permutation
+	(i.e. it comes from a shuffle or from the crossover), then only the edges are checked.
+*/
+int Genetic::isValidSolution(vector<int>& solution, bool check_genes)
+{
+	int total_cost = 0;
+	
+	if(check_genes)
+	{
+		vector<unsigned int>& visited_genes = buffers[0].visited_genes;
+		unsigned int stamp = buffers[0].newStamp();
+		
+		// checks if not contains elements repeated
+		for(int i = 0; i < graph->V; i++)
+		{
+			int gene = solution[i];
+			if(gene < 0 || gene >= graph->V || visited_genes[gene] == stamp)
+				return -1;
+			visited_genes[gene] = stamp;
+		}
+	}
+
+	// checks if connections are valid
+	for(int i = 0; i < graph->V; i++)
+	{
+		if(i + 1 <  graph->V)
+		{
+			int cost = graph->existsEdge(solution[i], solution[i+1]);
+			
+			// checks if exists connection
+			if(cost == -1)
+				return -1;
+			else
+				total_cost += cost;
+		}
+		else
+		{
+			int cost = graph->existsEdge(solution[i], solution[0]);
+			
+			// checks if exists connection
+			if(cost == -1)
+				return -1;
+			else
+				total_cost += cost;
+			break;
+		}
+	}
+	return total_cost;
+}
+
+
+/*
+	Returns the total cost of new_solution, knowing that it's equal to old_solution
+	(which costs old_cost) everywhere except between the positions first and last.
+	Only the edges that touch the segment are read, so it's O(segment) instead of O(V).
+	The hash of old_solution is updated to the hash of new_solution.
+	Returns -1 if one of the new edges doesn't exist.
+*/
+int Genetic::segmentCost(const vector<int>& old_solution, int old_cost, const vector<int>& new_solution, int first, int last, uint64_t& hash) const
+{
+	return segmentCost(&old_solution[0], old_cost, new_solution, first, last, hash);
+}
+
+
+// the old solution can be a vector or a slot of the population
+template<typename Gene>
+int Genetic::segmentCost(const Gene* old_solution, int old_cost, const vector<int>& new_solution, int first, int last, uint64_t& hash) const
+{
+	int total_cost = old_cost;
+	bool valid = true;
+	
+	// the edges that change go from position first - 1 to the one that leaves the segment,
+	// a segment of the whole solution (first = 0, last = V - 1) changes each edge only once
+	int amount_edges = min(last - first + 2, graph->V);
+	for(int i = first - 1; i < first - 1 + amount_edges; i++)
+	{
+		int src = (i + graph->V) % graph->V;
+		int dest = (i + 1) % graph->V;
+		
+		hash += edgeHash(new_solution[src], new_solution[dest]) - edgeHash(old_solution[src], old_solution[dest]);
+		
+		if(valid)
+		{
+			int cost = graph->existsEdge(new_solution[src], new_solution[dest]);
+			
+			// checks if exists connection
+			if(cost == -1)
+				valid = false;
+			else
+				total_cost += cost - graph->existsEdge(old_solution[src], old_solution[dest]);
+		}
+	}
+	return valid ? total_cost : -1;
+}
+
+
+/*
+	Swaps two genes of a solution that costs total_cost and returns the new cost.
+	Only the (at most 4) edges around the two genes change, so it's O(1).
+	The hash of the solution is updated too.
+	Returns -1 if one of the new edges doesn't exist (or if the solution was already invalid).
+*/
+int Genetic::swapGenes(vector<int>& solution, int total_cost, int index_gene1, int index_gene2, uint64_t& hash) const
+{
+	int V = graph->V;
+	bool valid = (total_cost != -1); // if the solution is invalid only the hash is updated
+	
+	// positions where the changed edges start, without repetitions
+	int edges[4] = { (index_gene1 + V - 1) % V, index_gene1, (index_gene2 + V - 1) % V, index_gene2 };
+	int size_edges = 0;
+	for(int i = 0; i < 4; i++)
+	{
+		bool repeated = false;
+		for(int j = 0; j < size_edges; j++)
+			repeated = repeated || (edges[j] == edges[i]);
+		if(!repeated)
+			edges[size_edges++] = edges[i];
+	}
+	
+	for(int i = 0; i < size_edges; i++)
+	{
+		hash -= edgeHash(solution[edges[i]], solution[(edges[i] + 1) % V]);
+		if(valid)
+			total_cost -= graph->existsEdge(solution[edges[i]], solution[(edges[i] + 1) % V]);
+	}
+	
+	int aux = solution[index_gene1];
+	solution[index_gene1] = solution[index_gene2];
+	solution[index_gene2] = aux;
+	
+	for(int i = 0; i < size_edges; i++)
+	{
+		hash += edgeHash(solution[edges[i]], solution[(edges[i] + 1) % V]);
+		if(valid)
+		{
+			int cost = graph->existsEdge(solution[edges[i]], solution[(edges[i] + 1) % V]);
+			
+			// checks if exists connection
+			if(cost == -1)
+				valid = false;
+			else
+				total_cost += cost;
+		}
+	}
+	return valid ? total_cost : -1;
+}
+
+
+uint64_t Genetic::solutionHash(const vector<int>& solution) const
+{
+	uint64_t hash = 0;
+	for(int i = 0; i < graph->V; i++)
+		hash += edgeHash(solution[i], solution[(i + 1) % graph->V]);
+	return hash;
+}
+
+
+bool Genetic::existsChromosome(const vector<int> & v)
+{
+	// checks if exists in the population
+	return hashes.count(solutionHash(v)) > 0;
+}
+
+
+void Genetic::initialPopulation() // generates the initial population
+{
+	vector<int> parent;
+	
+	// inserts initial vertex in the parent
+	parent.push_back(graph->initial_vertex);
+	
+	// creates the parent
+	for(int i = 0; i < graph->V; i++)
+	{
+		if(i != graph->initial_vertex)
+			parent.push_back(i);
+	}
+		
+	int total_cost = isValidSolution(parent, false); // it's a permutation, checks only the edges
+	
+	if(total_cost != -1) // checks if the parent is valid
+	{
+		insertBinarySearch(parent, total_cost, solutionHash(parent)); // inserts in the population
+		real_size_population++; // increments real_size_population
+	}
+	
+	// makes random permutations "generations" times
+	for(int i = 0; i < generations; i++)
+	{
+		// generates a random permutation
+		random_engine.shuffle(parent.begin() + 1, parent.begin() + (randomNumber(graph->V - 1) + 1));
+		
+		int total_cost = isValidSolution(parent, false); // checks if solution is valid (the shuffle keeps the genes)
+		uint64_t hash = solutionHash(parent);
+		
+		// checks if permutation is a valid solution and if not exists
+		if(total_cost != -1 && hashes.count(hash) == 0)
+		{
+			insertBinarySearch(parent, total_cost, hash); // add in population (sorted)
+			real_size_population++; // increments real_size_population in the unit
+		}
+		if(real_size_population == size_population) // checks size population
+			break;
+	}
+	
+	// checks if real_size_population is 0
+	if(real_size_population == 0)
+		cout << "\nEmpty initial population ;( Try again runs the algorithm...";
+}
+
+
+void Genetic::showPopulation()
+{
+	cout << "\nShowing solutions...\n\n";
+	vector<int> vec;
+	for(int rank = 0; rank < real_size_population; rank++)
+	{
+		getSolution(rank, vec); // gets the vector
+		
+		for(int i = 0; i < graph->V; i++)
+			cout << vec[i] << " ";
+		cout << graph->initial_vertex;
+		cout << " | Cost: " << getCost(rank) << "\n\n";
+	}
+	cout << "\nPopulation size: " << real_size_population << endl;
+}
+
+
+// copies the genes of a solution in a slot of the population
+template<typename Gene>
+static void storeGenes(vector<Gene>& slab, int slot, const vector<int>& solution)
+{
+	size_t V = solution.size();
+	Gene* genes = &slab[slot * V];
+	for(size_t i = 0; i < V; i++)
+		genes[i] = (Gene)solution[i];
+}
+
+
+// copies the genes of a slot of the population in a solution
+template<typename Gene>
+static void loadGenes(const vector<Gene>& slab, int slot, int V, vector<int>& solution)
+{
+	const Gene* genes = &slab[(size_t)slot * V];
+	solution.assign(genes, genes + V);
+}
+
+
+// stores a solution in a free slot (overwriting the old chromosome) and returns the slot
+int Genetic::newSlot(const vector<int>& solution, int total_cost, uint64_t hash)
+{
+	int slot = free_slots.back();
+	free_slots.pop_back();
+	
+	if(compact_genes)
+		storeGenes(genes16, slot, solution);
+	else
+		storeGenes(genes32, slot, solution);
+	slot_costs[slot] = total_cost;
+	slot_hashes[slot] = hash;
+	return slot;
+}
+
+
+// inserts in the ranking using binary search
+void Genetic::insertBinarySearch(const vector<int>& child, int total_cost, uint64_t hash)
+{
+	int imin = 0;
+	int imax = real_size_population - 1;
+	
+	hashes.insert(hash);
+	int slot = newSlot(child, total_cost, hash);
+	
+	while(imax >= imin)
+	{
+		int imid = imin + (imax - imin) / 2;
+		
+		if(total_cost == slot_costs[ranking[imid]])
+		{
+			ranking.insert(ranking.begin() + imid, slot);
+			return;
+		}
+		else if(total_cost > slot_costs[ranking[imid]])
+			imin = imid + 1;
+		else
+			imax = imid - 1;
+	}
+	ranking.insert(ranking.begin() + imin, slot);
+}
+
+
+// removes the last (worst) element of the ranking, its slot can be reused
+void Genetic::removeWorst()
+{
+	int slot = ranking.back();
+	hashes.erase(slot_hashes[slot]);
+	ranking.pop_back();
+	free_slots.push_back(slot);
+	real_size_population--; // decrements the real_size_population in the unit
+}
+
+
+int Genetic::getCost(int rank) const
+{
+	return slot_costs[ranking[rank]];
+}
+
+
+void Genetic::getSolution(int rank, vector<int>& solution) const
+{
+	if(compact_genes)
+		loadGenes(genes16, ranking[rank], graph->V, solution);
+	else
+		loadGenes(genes32, ranking[rank], graph->V, solution);
+}
+
+
+/*
+	Builds a child equal to parent, except for the positions between point1 and point2
+	that receive the substring inverted of other.
+	
+	The genes not used by the rest of the child are exactly the genes of the substring
+	of parent: they are kept in a doubly linked list (indexed by gene, in ascending
+	order like the old map of genes), so checking a gene, removing it and taking the
+	first unused gene are all O(1).
+	The whole child costs O(V) and uses only buffers allocated by the constructor.
+*/
+template<typename Gene>
+void Genetic::makeChild(const Gene* parent, const Gene* other, int point1, int point2, CrossoverBuffers& buffers, vector<int>& child)
+{
+	int V = graph->V;
+	vector<unsigned int>& visited_genes = buffers.visited_genes;
+	vector<int>& next_unused_gene = buffers.next_unused_gene;
+	vector<int>& prev_unused_gene = buffers.prev_unused_gene;
+	unsigned int stamp = buffers.newStamp(); // genes with this stamp are in the list
+	
+	child.assign(parent, parent + V); // prefix and suffix of the parent
+	
+	// marks the unused genes
+	for(int i = point1; i <= point2; i++)
+		visited_genes[parent[i]] = stamp;
+	
+	// list of unused genes, V is the head of the list
+	int last = V;
+	for(int gene = 0; gene < V; gene++)
+	{
+		if(visited_genes[gene] == stamp)
+		{
+			next_unused_gene[last] = gene;
+			prev_unused_gene[gene] = last;
+			last = gene;
+		}
+	}
+	next_unused_gene[last] = V;
+	prev_unused_gene[V] = last;
+	
+	// here is the substring inverted
+	for(int i = point2, j = point1; i >= point1; i--, j++)
+	{
+		int gene = other[i];
+		
+		// if the gene already is used, chooses the first gene that is not used
+		if(visited_genes[gene] != stamp)
+			gene = next_unused_gene[V];
+		
+		// marks the gene as used, removing it from the list
+		visited_genes[gene] = 0;
+		next_unused_gene[prev_unused_gene[gene]] = next_unused_gene[gene];
+		prev_unused_gene[next_unused_gene[gene]] = prev_unused_gene[gene];
+		
+		child[j] = gene;
+	}
+}
+
+
+/*
+	Makes the crossover
+	This crossover selects two random points
+	These points generates substrings in both parents
+	The substring inverted of parent1 is placed in parent2 and
+	the substring inverted of parent2 is placed in parent1
+	
+	Example:
+		parent1: 1 2 3 4 5
+		parent2: 1 2 4 5 3
+		
+		substring in parent1: 2 3 4
+		substring in parent2: 2 4 5
+		
+		substring inverted in parent1: 4 3 2
+		substring inverted in parent2: 5 4 2
+		
+		child1: 1 5 4 2 5
+		child2: 1 4 3 2 3
+		
+		Children are invalids: 5 appears 2x in child1 and 3 appears 2x in child2
+		Solution: list of genes that are not used (see makeChild)
+	
+	The children are equal to a parent outside [point1, point2], so their cost
+	is computed from the cost of the parent reading only the edges of the segment
+*/
+void Genetic::crossOver(int index_parent1, int index_parent2)
+{
+	// the children are built in buffers reused by every crossover
+	makeChildren(planCrossOver(index_parent1, index_parent2), buffers[0], children[0], children[1]);
+	
+	// checks if is a valid solution and not exists in the population
+	insertChild(children[0]);
+	
+	// checks again... (child2 can be equal to child1)
+	insertChild(children[1]);
+}
+
+
+// draws the random choices of a crossover
+CrossoverPlan Genetic::planCrossOver(int index_parent1, int index_parent2)
+{
+	CrossoverPlan plan;
+	plan.parent1 = index_parent1;
+	plan.parent2 = index_parent2;
+	
+	// generates random points
+	int point1 = randomNumber(graph->V - 1) + 1;
+	int point2 = randomNumber(graph->V - point1) + point1;
+	
+	// adjusts the points if they are equal, the substring stays in [1, V - 1]
+	// (position 0 is the initial vertex, V - 1 the last gene of the child)
+	if(point1 == point2)
+	{
+		if(point1 - 1 > 1)
+			point1--;
+		else if(point2 + 1 < graph->V)
+			point2++;
+		else if(point1 > 1)
+			point1--;
+		// with 2 vertices the substring is only the last gene
+	}
+	plan.point1 = point1;
+	plan.point2 = point2;
+	
+	// mutation
+	int mutation = randomNumber(100) + 1; // random number in [1,100]
+	plan.mutation = (mutation <= mutation_rate); // checks if the random number <= mutation rate
+	if(plan.mutation)
+	{
+		// makes a mutation: change of two genes
+		plan.index_gene1 = randomNumber(graph->V - 1) + 1;
+		plan.index_gene2 = randomNumber(graph->V - 1) + 1;
+	}
+	return plan;
+}
+
+
+// makes the children of a crossover, it only reads the population (can run on many threads)
+void Genetic::makeChildren(const CrossoverPlan& plan, CrossoverBuffers& buffers, Child& child1, Child& child2)
+{
+	if(compact_genes)
+		makeChildrenFrom(genes16, plan, buffers, child1, child2);
+	else
+		makeChildrenFrom(genes32, plan, buffers, child1, child2);
+}
+
+
+template<typename Gene>
+void Genetic::makeChildrenFrom(const vector<Gene>& slab, const CrossoverPlan& plan, CrossoverBuffers& buffers, Child& child1, Child& child2)
+{
+	int slot1 = ranking[plan.parent1];
+	int slot2 = ranking[plan.parent2];
+	const Gene* parent1 = &slab[(size_t)slot1 * graph->V];
+	const Gene* parent2 = &slab[(size_t)slot2 * graph->V];
+	
+	// generates childs
+	// child1 receives the substring inverted of parent2 and
+	// child2 receives the substring inverted of parent1
+	makeChild(parent1, parent2, plan.point1, plan.point2, buffers, child1.genes);
+	makeChild(parent2, parent1, plan.point1, plan.point2, buffers, child2.genes);
+	
+	// the children differ from their parents only in the inverted substring
+	child1.hash = slot_hashes[slot1];
+	child2.hash = slot_hashes[slot2];
+	child1.total_cost = segmentCost(parent1, slot_costs[slot1], child1.genes, plan.point1, plan.point2, child1.hash);
+	child2.total_cost = segmentCost(parent2, slot_costs[slot2], child2.genes, plan.point1, plan.point2, child2.hash);
+	
+	if(plan.mutation)
+	{
+		// makes for child1 and child2, updating only the costs of the edges around the genes
+		child1.total_cost = swapGenes(child1.genes, child1.total_cost, plan.index_gene1, plan.index_gene2, child1.hash);
+		child2.total_cost = swapGenes(child2.genes, child2.total_cost, plan.index_gene1, plan.index_gene2, child2.hash);
+		
+		// a missing edge in the substring can be fixed by the mutation, checks the whole child
+		if(child1.total_cost == -1)
+			child1.total_cost = isValidSolution(child1.genes, false);
+		if(child2.total_cost == -1)
+			child2.total_cost = isValidSolution(child2.genes, false);
+	}
+}
+
+
+// inserts a child in the population if it's a valid solution and not exists in the population
+bool Genetic::insertChild(Child& child)
+{
+	made_children++;
+	if(child.total_cost == -1)
+	{
+		invalid_children++;
+		return false;
+	}
+	else if(hashes.count(child.hash) > 0)
+	{
+		duplicate_children++;
+		return false;
+	}
+	
+	// add child in the population
+	insertBinarySearch(child.genes, child.total_cost, child.hash); // uses binary search to insert
+	real_size_population++; // increments the real_size_population
+	return true;
+}
+
+
+// selects two different random parents (if exists)
+void Genetic::selectParents(int& parent1, int& parent2)
+{
+	if(real_size_population == 1)
+	{
+		parent1 = parent2 = 0;
+	}
+	else if(real_size_population == 2)
+	{
+		parent1 = 0;
+		parent2 = 1;
+	}
+	else
+	{
+		do
+		{
+			// select two random parents
+			parent1 = randomNumber(real_size_population);
+			parent2 = randomNumber(real_size_population);
+		}while(parent1 == parent2);
+	}
+}
+
+
+// compares the costs of two children of a generation (the first made wins the ties)
+struct sort_children
+{
+	const vector<Child>& children;
+	sort_children(const vector<Child>& children) : children(children) {}
+	bool operator()(int first, int second) const
+	{
+		if(children[first].total_cost != children[second].total_cost)
+			return children[first].total_cost < children[second].total_cost;
+		return first < second;
+	}
+};
+
+
+/*
+	Makes a generation in generational mode:
+		1. draws the parents and the random choices of all the crossovers
+		2. makes all the children in parallel
+		3. merges the valid new children with the population (both sorted by cost)
+		   keeping the best size_population solutions
+*/
+void Genetic::nextBatchGeneration()
+{
+	int pairs = plans.size();
+	
+	for(int i = 0; i < pairs; i++)
+	{
+		int parent1, parent2;
+		selectParents(parent1, parent2);
+		plans[i] = planCrossOver(parent1, parent2);
+	}
+	
+	function<void(int, int, int)> job = [this](int worker, int first, int last)
+	{
+		for(int i = first; i < last; i++)
+			makeChildren(plans[i], buffers[worker], batch_children[2 * i], batch_children[2 * i + 1]);
+	};
+	if(pool != NULL)
+		pool->run(pairs, job);
+	else
+		job(0, 0, pairs);
+	
+	// valid children that don't exist, each hash is added now so the copies are discarded
+	accepted_children.clear();
+	for(int i = 0; i < 2 * pairs && i < children_per_generation; i++)
+	{
+		Child& child = batch_children[i];
+		made_children++;
+		if(child.total_cost == -1)
+			invalid_children++;
+		else if(!hashes.insert(child.hash))
+			duplicate_children++;
+		else
+			accepted_children.push_back(i);
+	}
+	sort(accepted_children.begin(), accepted_children.end(), sort_children(batch_children));
+	
+	/* merges the ranking and the children: an element of merged_ranking is a slot
+		of the population or -(child + 1) for a child, the old solution wins the ties */
+	merged_ranking.clear();
+	size_t i = 0, j = 0;
+	while(i < ranking.size() || j < accepted_children.size())
+	{
+		bool take_child = (i == ranking.size()) ||
+			(j < accepted_children.size() && batch_children[accepted_children[j]].total_cost < slot_costs[ranking[i]]);
+		
+		if(take_child)
+		{
+			int child = accepted_children[j++];
+			if((int)merged_ranking.size() < size_population)
+				merged_ranking.push_back(-(child + 1));
+			else
+				hashes.erase(batch_children[child].hash); // it doesn't enter the population
+		}
+		else
+		{
+			int slot = ranking[i++];
+			if((int)merged_ranking.size() < size_population)
+				merged_ranking.push_back(slot);
+			else
+			{
+				// it leaves the population, its slot receives a child
+				hashes.erase(slot_hashes[slot]);
+				free_slots.push_back(slot);
+			}
+		}
+	}
+	
+	// the children that entered overwrite the free slots
+	for(size_t k = 0; k < merged_ranking.size(); k++)
+	{
+		if(merged_ranking[k] < 0)
+		{
+			Child& child = batch_children[-merged_ranking[k] - 1];
+			merged_ranking[k] = newSlot(child.genes, child.total_cost, child.hash);
+		}
+	}
+	
+	ranking.swap(merged_ranking);
+	real_size_population = ranking.size();
+}
+
+
+// makes a generation: two parents make (at most) two children that replace the worst solutions
+void Genetic::nextGeneration()
+{
+	if(graph->V < 2) // a single gene can't be crossed
+		return;
+	
+	if(children_per_generation > 0)
+	{
+		nextBatchGeneration();
+		return;
+	}
+	
+	int  old_size_population = real_size_population;
+	
+	/* selects two parents (the same one if the population has only one) who will
+		participate of the reproduction process, like the generational mode */
+	int parent1, parent2;
+	selectParents(parent1, parent2);
+	
+	// applying crossover in the parents
+	crossOver(parent1, parent2);
+	
+	if(parent1 != parent2)
+	{
+		// gets difference to check if the population grew 
+		int diff_population = real_size_population - old_size_population;
+		
+		if(diff_population == 2)
+		{
+			if(real_size_population > size_population)
+			{
+				// removes the two worst parents of the population
+				removeWorst();
+				removeWorst();
+			}
+		}
+		else if(diff_population == 1)
+		{
+			if(real_size_population > size_population)
+				removeWorst(); // removes the worst parent of the population
+		}
+	} 
+	else // population contains only 1 parent
+	{
+		if(real_size_population > size_population)
+			removeWorst(); // removes the worst parent of the population
+	}
+}
+
+
+// runs the genetic algorithm
+void Genetic::run()
+{
+	runUntil(chrono::steady_clock::time_point::max(), NULL);
+	
+	if(real_size_population == 0)
+		return;
+	
+	if(show_population == true)
+		showPopulation(); // shows the population
+	
+	cout << "\nBest solution: ";
+	vector<int> vec;
+	getSolution(0, vec);
+	for(int i = 0; i < graph->V; i++)
+		cout << vec[i] << " ";
+	cout << graph->initial_vertex;
+	cout << " | Cost: " << getCost(0);
+}
+
+
+/*
+	Anytime run: makes the generations until the deadline (checked between two generations)
+	or until all the generations are made. improved (if any) receives the best solution
+	and its cost after the initial population and every time a generation improves it.
+	The initial population isn't interrupted.
+	With a telemetry (see setTelemetry) the statistics are recorded after the initial
+	population, every interval generations and after the last generation.
+*/
+int Genetic::runUntil(chrono::steady_clock::time_point deadline, const function<void(const vector<int>&, int)>& improved)
+{
+	chrono::steady_clock::time_point begin_time = chrono::steady_clock::now();
+	initialPopulation(); // gets initial population
+	
+	if(real_size_population == 0)
+		return 0;
+	
+	made_children = invalid_children = duplicate_children = 0;
+	if(telemetry != NULL)
+		recordStats(0, begin_time);
+	
+	vector<int> best;
+	int best_cost = getCost(0);
+	if(improved)
+	{
+		getSolution(0, best);
+		improved(best, best_cost);
+	}
+	
+	// the threads of the generational mode live until the end of the run
+	WorkerPool* workers = NULL;
+	if(children_per_generation > 0 && threads_per_generation > 1)
+		workers = new WorkerPool(threads_per_generation);
+	pool = workers;
+
+	int generation = 0;
+	for(; generation < generations && chrono::steady_clock::now() < deadline; generation++)
+	{
+		nextGeneration();
+		
+		if(getCost(0) < best_cost)
+		{
+			best_cost = getCost(0);
+			if(improved)
+			{
+				getSolution(0, best);
+				improved(best, best_cost);
+			}
+		}
+		
+		if(telemetry != NULL && (generation + 1) % telemetry->getInterval() == 0)
+			recordStats(generation + 1, begin_time);
+	}
+	
+	// the last generation, if it wasn't recorded
+	if(telemetry != NULL && generation % telemetry->getInterval() != 0)
+		recordStats(generation, begin_time);
+	
+	pool = NULL;
+	delete workers;
+	return generation;
+}
+
+
+// sends the statistics of the population to the telemetry and starts counting the children again
+void Genetic::recordStats(int generation, chrono::steady_clock::time_point begin_time)
+{
+	GenerationStats stats;
+	stats.generation = generation;
+	stats.best_cost = getCost(0);
+	
+	double sum_costs = 0;
+	for(int i = 0; i < real_size_population; i++)
+		sum_costs += slot_costs[ranking[i]];
+	stats.mean_cost = sum_costs / real_size_population;
+	
+	stats.children = made_children;
+	stats.invalid_children = invalid_children;
+	stats.duplicate_children = duplicate_children;
+	stats.diversity = diversity();
+	stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - begin_time).count();
+	telemetry->record(stats);
+	
+	made_children = invalid_children = duplicate_children = 0;
+}
+
+
+/*
+	Diversity of the population: the edges of the best solution are compared with
+	the edges of at most 8 other solutions spread over the ranking (the last one is
+	the worst), so it costs O(V) for each of them. 0 is a population of copies of the
+	best solution and 1 a population that shares no edge with it.
+*/
+double Genetic::diversity()
+{
+	int V = graph->V;
+	if(real_size_population < 2 || V < 2)
+		return 0;
+	
+	getSolution(0, sampled_genes);
+	best_next.resize(V);
+	for(int i = 0; i < V; i++)
+		best_next[sampled_genes[i]] = sampled_genes[(i + 1) % V];
+	
+	int samples = min(real_size_population - 1, 8);
+	long missing_edges = 0;
+	for(int s = 1; s <= samples; s++)
+	{
+		getSolution((int)((long)s * (real_size_population - 1) / samples), sampled_genes);
+		for(int i = 0; i < V; i++)
+		{
+			int src = sampled_genes[i];
+			int dest = sampled_genes[(i + 1) % V];
+			
+			// in symmetric graphs a edge can be in the best solution in the other direction
+			if(best_next[src] != dest && !(graph->isSymmetric() && best_next[dest] == src))
+				missing_edges++;
+		}
+	}
+	return (double)missing_edges / ((double)samples * V);
+}
+
+
+// adds a solution that comes from another population, if it's not already in the population
+bool Genetic::immigrate(const vector<int>& solution, int total_cost)
+{
+	uint64_t hash = solutionHash(solution);
+	
+	if(total_cost == -1 || hashes.count(hash) > 0)
+		return false;
+	
+	insertBinarySearch(solution, total_cost, hash);
+	real_size_population++;
+	
+	if(real_size_population > size_population)
+		removeWorst(); // removes the worst parent of the population
+	return true;
+}
+
+
+int Genetic::getCostBestSolution()
+{
+	if(real_size_population > 0)
+		return getCost(0);
+	return -1;
+}
+
+
+vector<int> Genetic::getBestSolution() const
+{
+	vector<int> solution;
+	if(real_size_population > 0)
+		getSolution(0, solution);
+	return solution;
+}
+
+
+GeneticTelemetry::GeneticTelemetry(int interval, size_t capacity)
+{
+	if(interval < 1) // checks if the generations between two records are less than 1
+	{
+		cout << "Error: interval < 1\n";
+		exit(1);
+	}
+	else if(capacity < 1)
+	{
+		cout << "Error: capacity < 1\n";
+		exit(1);
+	}
+	
+	this->interval = interval;
+	this->records.resize(capacity);
+	this->next_record = 0;
+	this->amount_records = 0;
+}
+
+
+// the rates are the rejected children over the children made since the previous line
+void GeneticTelemetry::openCsv(const string& csv_file)
+{
+	csv.open(csv_file.c_str());
+	if(!csv)
+	{
+		cout << "Error: can't write " << csv_file << "\n";
+		exit(1);
+	}
+	csv << "generation,best_cost,mean_cost,children,invalid_rate,duplicate_rate,diversity,seconds\n";
+}
+
+
+void GeneticTelemetry::record(const GenerationStats& stats)
+{
+	records[next_record] = stats;
+	next_record = (next_record + 1) % records.size();
+	amount_records++;
+	
+	// buffered by the stream, written when the buffer is full or the file is closed
+	if(csv.is_open())
+	{
+		double children = max(stats.children, 1);
+		csv << stats.generation << ',' << stats.best_cost << ',' << stats.mean_cost << ',' << stats.children << ','
+			<< stats.invalid_children / children << ',' << stats.duplicate_children / children << ','
+			<< stats.diversity << ',' << stats.seconds << '\n';
+	}
+}
+
+
+void GeneticTelemetry::getHistory(vector<GenerationStats>& history) const
+{
+	size_t amount = min(amount_records, records.size());
+	size_t first = (next_record + records.size() - amount) % records.size();
+	
+	history.clear();
+	for(size_t i = 0; i < amount; i++)
+		history.push_back(records[(first + i) % records.size()]);
+}
+
+
+/*
+	Island model: many populations (islands) evolve in parallel on worker threads and
+	every migration_interval generations the best solution of each island migrates
+	to another island (the next one with RING topology, a random one with RANDOM).
+	
+	The islands are divided among the threads, every island has its own random numbers
+	and the migrations happen between two epochs, when all the threads are stopped:
+	the results depend only on the seed (not on the thread scheduling).
+*/
+GeneticIslands::GeneticIslands(Graph* graph, int amount_islands, int threads, int size_population, int generations, int mutation_rate, int migration_interval, int topology, uint64_t seed)
+{
+	if(amount_islands < 1) // checks if number of islands is less than 1
+	{
+		cout << "Error: amount_islands < 1\n";
+		exit(1);
+	}
+	else if(migration_interval < 1)
+	{
+		cout << "Error: migration_interval < 1\n";
+		exit(1);
+	}
+	
+	this->graph = graph;
+	this->generations = generations;
+	this->migration_interval = migration_interval;
+	this->topology = topology;
+	this->threads = max(1, min(threads, amount_islands)); // no thread without islands
+	
+	// a different seed for each island, all of them depend on seed
+	Random seeds(seed);
+	
+	islands.reserve(amount_islands);
+	for(int i = 0; i < amount_islands; i++)
+	{
+		islands.push_back(Genetic(graph, size_population, generations, mutation_rate, false));
+		islands.back().setSeed(seeds.next());
+	}
+	random_engine.setSeed(seeds.next());
+}
+
+
+// evolves the islands of a thread: first_island, first_island + threads, ...
+void GeneticIslands::evolve(int first_island, int generations, bool initial_population)
+{
+	for(size_t i = first_island; i < islands.size(); i += threads)
+	{
+		if(initial_population)
+			islands[i].initialPopulation();
+		
+		if(islands[i].real_size_population == 0)
+			continue;
+		
+		for(int j = 0; j < generations; j++)
+			islands[i].nextGeneration();
+	}
+}
+
+
+// the best solution of each island migrates to another island
+void GeneticIslands::migrate()
+{
+	int amount_islands = islands.size();
+	
+	if(amount_islands < 2)
+		return;
+	
+	// copies the emigrants first, so the order of the migrations doesn't matter
+	vector<pair<vector<int>, int> > emigrants;
+	vector<int> destinations;
+	for(int i = 0; i < amount_islands; i++)
+	{
+		if(islands[i].real_size_population == 0)
+			continue;
+		
+		int destination = (i + 1) % amount_islands;
+		if(topology == RANDOM)
+		{
+			// any island except itself
+			destination = random_engine.uniform(amount_islands - 1);
+			if(destination >= i)
+				destination++;
+		}
+		
+		emigrants.push_back(make_pair(islands[i].getBestSolution(), islands[i].getCostBestSolution()));
+		destinations.push_back(destination);
+	}
+	
+	for(size_t i = 0; i < emigrants.size(); i++)
+		islands[destinations[i]].immigrate(emigrants[i].first, emigrants[i].second);
+}
+
+
+// runs the islands
+void GeneticIslands::run()
+{
+	int done_generations = 0;
+	bool initial_population = true;
+	
+	do
+	{
+		int epoch = min(migration_interval, generations - done_generations);
+		
+		vector<thread> workers;
+		for(int t = 0; t < threads; t++)
+			workers.push_back(thread(&GeneticIslands::evolve, this, t, epoch, initial_population));
+		for(int t = 0; t < threads; t++)
+			workers[t].join();
+		
+		initial_population = false;
+		done_generations += epoch;
+		
+		if(done_generations < generations)
+			migrate();
+	}while(done_generations < generations);
+}
+
+
+// returns the index of the island with the best solution, -1 if all the islands are empty
+int GeneticIslands::bestIsland()
+{
+	int best = -1;
+	for(size_t i = 0; i < islands.size(); i++)
+	{
+		int cost = islands[i].getCostBestSolution();
+		if(cost != -1 && (best == -1 || cost < islands[best].getCostBestSolution()))
+			best = i;
+	}
+	return best;
+}
+
+
+int GeneticIslands::getCostBestSolution()
+{
+	int best = bestIsland();
+	return (best == -1) ? -1 : islands[best].getCostBestSolution();
+}
+
+
+// returns the best solution of all the islands (empty if there isn't a solution)
+vector<int> GeneticIslands::getBestSolution()
+{
+	int best = bestIsland();
+	return (best == -1) ? vector<int>() : islands[best].getBestSolution();
+}
+
+
+WorkerPool::WorkerPool(int threads)
+{
+	job = NULL;
+	job_size = 0;
+	job_id = 0;
+	pending_workers = 0;
+	stopping = false;
+	
+	// the thread that calls run is a worker too
+	for(int i = 1; i < threads; i++)
+		workers.push_back(thread(&WorkerPool::work, this, i));
+}
+
+
+WorkerPool::~WorkerPool()
+{
+	{
+		lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake_workers.notify_all();
+	
+	for(size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+}
+
+
+// runs the range of [0, job_size) that belongs to a worker
+void WorkerPool::runPart(int worker)
+{
+	int parts = size();
+	int first = (int)((long long)job_size * worker / parts);
+	int last = (int)((long long)job_size * (worker + 1) / parts);
+	
+	if(first < last)
+		(*job)(worker, first, last);
+}
+
+
+void WorkerPool::work(int worker)
+{
+	int last_job_id = 0;
+	
+	while(true)
+	{
+		{
+			unique_lock<std::mutex> lock(mutex);
+			while(!stopping && job_id == last_job_id)
+				wake_workers.wait(lock);
+			if(stopping)
+				return;
+			last_job_id = job_id;
+		}
+		
+		runPart(worker);
+		
+		lock_guard<std::mutex> lock(mutex);
+		if(--pending_workers == 0)
+			job_done.notify_one();
+	}
+}
+
+
+// runs job(worker, first, last) splitting [0, size) among the workers, returns when all the parts are done
+void WorkerPool::run(int size, const function<void(int, int, int)>& job)
+{
+	{
+		lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		this->job_size = size;
+		this->pending_workers = workers.size();
+		this->job_id++;
+	}
+	wake_workers.notify_all();
+	
+	runPart(0);
+	
+	unique_lock<std::mutex> lock(mutex);
+	while(pending_workers > 0)
+		job_done.wait(lock);
+}
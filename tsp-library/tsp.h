@@ -0,0 +1,483 @@
+#ifndef TSP_H
+#define TSP_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <utility> // pair
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t
+#include <math.h> // sqrt
+#include <time.h> // time
+#include <stdlib.h> // exit
+
+
+/*
+	Random numbers of the solvers: xoshiro256** seeded with splitmix64.
+	Each object has its own state, so every thread (or population) draws its own
+	sequence and the results depend only on the seed, never on rand()/srand().
+	uniform(n) is unbiased (Lemire's multiply and reject), unlike rand() % n.
+*/
+class Random
+{
+private:
+	uint64_t state[4];
+	static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+public:
+	Random(uint64_t seed = 0) { setSeed(seed); }
+	void setSeed(uint64_t seed); // same seed, same sequence
+	uint64_t next(); // 64 random bits
+	int uniform(int n); // random number in [0, n), n > 0
+	template<typename Iterator> void shuffle(Iterator first, Iterator last); // random permutation
+};
+
+
+inline void Random::setSeed(uint64_t seed)
+{
+	// splitmix64: any seed (0 too) gives a state that is not all zeros
+	for(int i = 0; i < 4; i++)
+	{
+		uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		state[i] = z ^ (z >> 31);
+	}
+}
+
+
+inline uint64_t Random::next()
+{
+	uint64_t result = rotl(state[1] * 5, 7) * 9;
+	uint64_t t = state[1] << 17;
+	
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+	return result;
+}
+
+
+inline int Random::uniform(int n)
+{
+	uint32_t range = (uint32_t)n;
+	uint64_t m = (next() >> 32) * range;
+	uint32_t low = (uint32_t)m;
+	
+	// rejects the few values that would make some numbers more likely
+	if(low < range)
+	{
+		uint32_t threshold = (0u - range) % range;
+		while(low < threshold)
+		{
+			m = (next() >> 32) * range;
+			low = (uint32_t)m;
+		}
+	}
+	return (int)(m >> 32);
+}
+
+
+// Fisher-Yates shuffle
+template<typename Iterator>
+inline void Random::shuffle(Iterator first, Iterator last)
+{
+	for(int i = (int)(last - first) - 1; i > 0; i--)
+	{
+		int j = uniform(i + 1);
+		std::swap(first[i], first[j]);
+	}
+}
+
+
+// a point of a geometric graph
+struct Point2D
+{
+	float x;
+	float y;
+};
+
+
+/*
+	The weights are stored in a dense row-major matrix, so every lookup
+	is an indexed load over contiguous memory.
+	
+	Storage flags (can be combined):
+		FULL      --> V * V matrix, one weight for each direction
+		SYMMETRIC --> upper triangular matrix (diagonal included),
+		              the weight of src->dest is the same of dest->src
+		COMPACT   --> 16 bits weights instead of 32 bits
+	
+	Missing edges are stored as -1 (NO_EDGE_16 with COMPACT storage).
+	
+	A geometric graph (GEOMETRIC) has no matrix at all: it keeps the points
+	and computes the weight of an edge only when it's needed, as the rounded
+	euclidean distance between its two vertices. Every pair of vertices is linked.
+	
+	A graph of the points with another metric (see metric.h) computes all its
+	weights once in a SYMMETRIC matrix: the weight is the distance * scale, rounded
+	(a machine time in seconds needs a scale like 1000 to keep its milliseconds).
+	
+	A TSPLIB instance (.tsp file) gives a graph with the weights of TSPLIB:
+		EUC_2D    --> geometric graph (rounded euclidean distances)
+		ATT       --> pseudo-euclidean distances in a SYMMETRIC matrix
+		EXPLICIT  --> the weights of the file, FULL_MATRIX (SYMMETRIC storage for a TSP,
+		              FULL for an ATSP) or a triangle: UPPER_ROW, LOWER_ROW,
+		              UPPER_DIAG_ROW or LOWER_DIAG_ROW
+	The vertices are numbered from 0 (TSPLIB numbers them from 1).
+*/
+class Graph
+{
+private:
+	int64_t total_edges; // total of edges (V * (V - 1) / 2 in a geometric graph, more than an int)
+	int initial_vertex; // initial vertex
+	int storage; // storage flags
+	std::vector<int> weights; // matrix of the weights (32 bits)
+	std::vector<unsigned short> compact_weights; // matrix of the weights (16 bits)
+	std::vector<Point2D> points; // coordinates of the vertices (geometric graph or TSPLIB coordinates)
+	std::string name; // name of a TSPLIB instance
+	size_t edgeIndex(int src, int dest) const; // position of a edge in the matrix
+	void setWeight(size_t index, int weight); // stores a weight in the matrix
+public:
+	enum Storage
+	{
+		FULL = 0,
+		SYMMETRIC = 1,
+		COMPACT = 2,
+		GEOMETRIC = 4
+	};
+	static const unsigned short NO_EDGE_16 = 0xFFFF; // missing edge with COMPACT storage
+	
+	Graph(int V, int initial_vertex, bool random_graph = false, int storage = FULL, uint64_t seed = 0); // constructor
+	Graph(const std::vector<Point2D>& points, int initial_vertex); // constructor of a geometric graph
+	template<typename Metric> Graph(const std::vector<Point2D>& points, int initial_vertex, const Metric& metric, double scale = 1); // constructor of a graph of the points with a metric
+	Graph(const std::string& tsplib_file, int initial_vertex = 0); // constructor of a TSPLIB instance
+	int V; // number of vertices
+	void addEdge(int v1, int v2, int weight); // adds a edge
+	void loadMatrix(const std::vector<int>& matrix); // adds all the edges at once
+	void showGraph(); // shows all the links of the graph
+	void generatesGraph(uint64_t seed = 0); // generates a random graph
+	void showInfoGraph(); // shows info of the graph
+	int existsEdge(int src, int dest) const; // checks if exists a edge
+	bool isSymmetric() const { return (storage & SYMMETRIC) != 0; }
+	const std::vector<Point2D>& getPoints() const { return points; } // coordinates of the vertices, empty if there are none
+	const std::string& getName() const { return name; } // name of a TSPLIB instance
+	int tourCost(const std::vector<int>& tour) const; // cost of a closed tour, -1 if an edge is missing
+	friend class Genetic; // to access private membres this class
+};
+
+
+// TSPLIB tours (.tour files), the vertices numbered from 0 like the solutions of Genetic
+void writeTsplibTour(const std::string& tour_file, const std::string& name, const std::vector<int>& tour, int cost = -1); // writes a tour (cost in the comment if it's not -1)
+void readTsplibTour(const std::string& tour_file, std::vector<int>& tour); // reads the first tour of a file
+
+
+inline size_t Graph::edgeIndex(int src, int dest) const
+{
+	if(storage & SYMMETRIC)
+	{
+		if(src > dest)
+		{
+			int aux = src;
+			src = dest;
+			dest = aux;
+		}
+		// row src starts after the previous rows: V + (V - 1) + ... + (V - src + 1)
+		return (size_t)src * (2 * V - src + 1) / 2 + (dest - src);
+	}
+	return (size_t)src * V + dest;
+}
+
+
+template<typename Metric>
+Graph::Graph(const std::vector<Point2D>& points, int initial_vertex, const Metric& metric, double scale)
+	: Graph(points.size(), initial_vertex, false, SYMMETRIC)
+{
+	for(int src = 0; src < V; src++)
+		for(int dest = src + 1; dest < V; dest++)
+			setWeight(edgeIndex(src, dest), (int)(metric(points[src], points[dest]) * scale + 0.5));
+}
+
+
+// returns the cost of the edge or -1 if the edge doesn't exist
+inline int Graph::existsEdge(int src, int dest) const
+{
+	if(storage & GEOMETRIC)
+	{
+		if(src == dest)
+			return -1;
+		
+		double dx = points[src].x - points[dest].x;
+		double dy = points[src].y - points[dest].y;
+		return (int)(sqrt(dx * dx + dy * dy) + 0.5); // rounded distance
+	}
+	
+	size_t index = edgeIndex(src, dest);
+	
+	if(storage & COMPACT)
+	{
+		unsigned short weight = compact_weights[index];
+		return (weight == NO_EDGE_16) ? -1 : weight;
+	}
+	return weights[index];
+}
+
+// random choices of a crossover (see Genetic::crossOver), drawn before making the children
+struct CrossoverPlan
+{
+	int parent1, parent2; // ranks of the parents in the population
+	int point1, point2; // positions of the substring
+	bool mutation; // true if the children have a mutation
+	int index_gene1, index_gene2; // genes swapped by the mutation
+};
+
+// buffers used to make the children, each thread that makes children needs its own
+struct CrossoverBuffers
+{
+	std::vector<unsigned int> visited_genes; // stamp of the last check that marked each gene
+	unsigned int current_stamp; // stamp of the current check
+	std::vector<int> next_unused_gene, prev_unused_gene; // list of unused genes of the crossover
+	void allocate(int V); // allocates the buffers for V genes
+	unsigned int newStamp(); // returns a new stamp for visited_genes
+};
+
+// a child made by the crossover
+struct Child
+{
+	std::vector<int> genes; // the solution
+	int total_cost; // cost of the solution, -1 if it's invalid
+	uint64_t hash; // hash of the solution
+};
+
+
+// threads that split the same job, they wait for the next job between two jobs
+class WorkerPool
+{
+private:
+	std::vector<std::thread> workers; // the threads (the caller of run works too)
+	std::mutex mutex;
+	std::condition_variable wake_workers, job_done;
+	const std::function<void(int, int, int)>* job; // current job: worker, first, last
+	int job_size; // the job is split in ranges of [0, job_size)
+	int job_id; // incremented for every job
+	int pending_workers; // workers still running the current job
+	bool stopping; // the destructor is waiting for the workers
+private:
+	void work(int worker); // loop of a thread
+	void runPart(int worker); // runs the range of a worker
+public:
+	WorkerPool(int threads); // constructor
+	~WorkerPool(); // destructor
+	void run(int size, const std::function<void(int, int, int)>& job); // runs job(worker, first, last) on [0, size)
+	int size() const { return workers.size() + 1; }
+};
+
+
+// statistics of the population after a generation (see GeneticTelemetry)
+struct GenerationStats
+{
+	int generation; // generations made (0 is the initial population)
+	int best_cost; // cost of the best solution
+	double mean_cost; // mean cost of the population
+	int children; // children made since the previous statistics
+	int invalid_children; // children rejected because an edge is missing
+	int duplicate_children; // children rejected because they are already in the population
+	double diversity; // fraction of the edges of the best solution missing in the others, from 0 to 1
+	double seconds; // time since the start of the run
+};
+
+
+/*
+	Sink of the statistics of the generations of a Genetic (see Genetic::setTelemetry):
+	every interval generations it keeps the statistics in a ring buffer of the last
+	capacity ones and, if a CSV file is open, writes them as a line of the file.
+	
+	The statistics cost O(size of the population + V) for each record and the
+	counters of the children one increment for each child, so with an interval
+	like 100 they can be left on.
+*/
+class GeneticTelemetry
+{
+private:
+	int interval; // generations between two records
+	std::vector<GenerationStats> records; // ring buffer of the last records
+	size_t next_record; // position of the next record in records
+	size_t amount_records; // records made (the ring buffer keeps the last ones)
+	std::ofstream csv; // CSV file of the records (if it's open)
+public:
+	GeneticTelemetry(int interval = 1, size_t capacity = 1024); // constructor
+	void openCsv(const std::string& csv_file); // writes the records in a CSV file too
+	void record(const GenerationStats& stats); // keeps a record
+	int getInterval() const { return interval; }
+	size_t getAmountRecords() const { return amount_records; }
+	void getHistory(std::vector<GenerationStats>& history) const; // records of the ring buffer, the oldest first
+};
+
+
+/*
+	Set of the hashes of a population (see Genetic::edgeHash): open addressing with
+	linear probing in a table of 2^k cells, the removed hashes leave a tombstone.
+	reserve allocates the table for a number of hashes and a spare table of the same
+	size, so insert and erase never allocate: when the tombstones and the hashes fill
+	half of the cells the hashes are moved to the spare table (without tombstones)
+	and the tables are swapped.
+*/
+class HashSet
+{
+private:
+	enum CellState
+	{
+		EMPTY = 0,
+		FULL = 1,
+		REMOVED = 2 // tombstone, a probe goes on after it
+	};
+	std::vector<uint64_t> keys, spare_keys; // cells of the table and of the spare table
+	std::vector<unsigned char> states, spare_states; // CellState of each cell
+	size_t mask; // cells - 1
+	size_t amount_full; // hashes in the table
+	size_t amount_removed; // tombstones in the table
+	size_t findCell(uint64_t key) const; // cell of key, or the first free cell of its probe if it's not there
+	void rebuild(); // moves the hashes to the spare table, without the tombstones
+public:
+	HashSet() : mask(0), amount_full(0), amount_removed(0) {}
+	void reserve(size_t amount); // room for amount hashes (the only allocation)
+	size_t count(uint64_t key) const; // 1 if key is in the set, else 0
+	bool insert(uint64_t key); // adds key, false if it was already in the set
+	void erase(uint64_t key); // removes key (if it's in the set)
+	size_t size() const { return amount_full; }
+};
+
+
+// class that represents genetic algorithm
+class Genetic
+{
+private:
+	Graph* graph; // the graph
+	int size_population; // size of population
+	int real_size_population; // real size population
+	int generations; // amount of generations
+	int mutation_rate; // mutation rate
+	bool show_population; // flag to show population
+	bool compact_genes; // true if the genes fit in 16 bits (V <= 65536)
+	std::vector<unsigned short> genes16; // chromosomes of the population, a slot of V genes each (if compact_genes)
+	std::vector<int> genes32; // chromosomes of the population (if not compact_genes)
+	std::vector<int> slot_costs; // total cost of the chromosome of each slot
+	std::vector<uint64_t> slot_hashes; // hash of the chromosome of each slot
+	std::vector<int> ranking; // slots of the population sorted by cost (the best first)
+	std::vector<int> free_slots; // slots that are not in the population
+	std::vector<int> merged_ranking; // new ranking of a generation in generational mode
+	HashSet hashes; // hashes of the population, to find duplicates
+	std::vector<CrossoverBuffers> buffers; // buffers of each thread (0 is the calling thread)
+	Child children[2]; // children of the steady state crossover
+	Random random_engine; // random numbers of this population
+	int children_per_generation; // 0 for steady state, else children made by a generation
+	int threads_per_generation; // threads that make the children of a generation
+	WorkerPool* pool; // threads of the generational mode (only while running)
+	std::vector<CrossoverPlan> plans; // crossovers of a generation
+	std::vector<Child> batch_children; // children of a generation
+	std::vector<int> accepted_children; // children of a generation that enter the population
+	GeneticTelemetry* telemetry; // sink of the statistics of the generations (NULL if there isn't)
+	int made_children, invalid_children, duplicate_children; // children since the last statistics
+	std::vector<int> best_next; // next gene of each gene in the best solution (diversity)
+	std::vector<int> sampled_genes; // a solution copied to measure the diversity
+private:
+	void initialPopulation(); // generates the initial population
+	void nextGeneration(); // makes a generation
+	void nextBatchGeneration(); // makes a generation in generational mode
+	int randomNumber(int n); // random number in [0, n)
+	void selectParents(int& parent1, int& parent2); // random parents
+	CrossoverPlan planCrossOver(int parent1, int parent2); // random choices of a crossover
+	void makeChildren(const CrossoverPlan& plan, CrossoverBuffers& buffers, Child& child1, Child& child2); // makes the children of a crossover
+	template<typename Gene> void makeChildrenFrom(const std::vector<Gene>& slab, const CrossoverPlan& plan, CrossoverBuffers& buffers, Child& child1, Child& child2);
+	template<typename Gene> void makeChild(const Gene* parent, const Gene* other, int point1, int point2, CrossoverBuffers& buffers, std::vector<int>& child); // builds a child
+	template<typename Gene> int segmentCost(const Gene* old_solution, int old_cost, const std::vector<int>& new_solution, int first, int last, uint64_t& hash) const;
+	int newSlot(const std::vector<int>& solution, int total_cost, uint64_t hash); // stores a solution in a free slot
+	bool insertChild(Child& child); // inserts a child if it's valid and it doesn't exist
+	void removeWorst(); // removes the last (worst) element of the population
+	void recordStats(int generation, std::chrono::steady_clock::time_point begin_time); // sends the statistics to the telemetry
+	double diversity(); // fraction of the edges of the best solution missing in other solutions
+public:
+	Genetic(Graph* graph, int amount_population, int generations, int mutation_rate, bool show_population = true); // constructor
+	int isValidSolution(std::vector<int>& solution, bool check_genes = true); // checks if a solution is valid
+	uint64_t edgeHash(int src, int dest) const; // hash of a edge
+	uint64_t solutionHash(const std::vector<int>& solution) const; // hash of a solution
+	int segmentCost(const std::vector<int>& old_solution, int old_cost, const std::vector<int>& new_solution, int first, int last, uint64_t& hash) const; // cost after changing a segment
+	int swapGenes(std::vector<int>& solution, int total_cost, int index_gene1, int index_gene2, uint64_t& hash) const; // swaps two genes and updates the cost
+	void showPopulation(); // shows population
+	void crossOver(int parent1, int parent2); // makes the crossover
+	void insertBinarySearch(const std::vector<int>& child, int total_cost, uint64_t hash); // uses binary search to insert
+	void run(); // runs genetic algorithm
+	int runUntil(std::chrono::steady_clock::time_point deadline, const std::function<void(const std::vector<int>&, int)>& improved); // runs until the deadline, returns the generations made
+	int getSizePopulation() const { return real_size_population; }
+	int getCost(int rank) const; // cost of a solution, rank 0 is the best
+	void getSolution(int rank, std::vector<int>& solution) const; // copies a solution, rank 0 is the best
+	int getCostBestSolution(); // returns cost of the best solution
+	std::vector<int> getBestSolution() const; // returns the best solution (empty if there isn't a solution)
+	bool existsChromosome(const std::vector<int> & v); // checks if exists the chromosome
+	bool immigrate(const std::vector<int>& solution, int total_cost); // adds a solution of another population
+	void setSeed(uint64_t seed); // seed of the random numbers
+	void setGenerationalMode(int children_per_generation, int threads); // makes many children in each generation
+	void setTelemetry(GeneticTelemetry* telemetry) { this->telemetry = telemetry; } // statistics of the generations (NULL to stop them)
+	friend class GeneticIslands; // to run the generations of many populations
+};
+
+
+// class that runs many genetic algorithms in parallel (island model)
+class GeneticIslands
+{
+private:
+	Graph* graph; // the graph
+	std::vector<Genetic> islands; // the populations
+	int threads; // amount of worker threads
+	int generations; // amount of generations of each island
+	int migration_interval; // generations between two migrations
+	int topology; // where the best solutions migrate
+	Random random_engine; // chooses the destinations of the migrations
+private:
+	void evolve(int first_island, int generations, bool initial_population); // evolves the islands of a thread
+	void migrate(); // the best solutions migrate between islands
+	int bestIsland(); // index of the island with the best solution
+public:
+	enum Topology
+	{
+		RING = 0,
+		RANDOM = 1
+	};
+	
+	GeneticIslands(Graph* graph, int amount_islands, int threads, int size_population, int generations, int mutation_rate, int migration_interval, int topology = RING, uint64_t seed = 0); // constructor
+	void run(); // runs the islands
+	int getCostBestSolution(); // returns cost of the best solution
+	std::vector<int> getBestSolution(); // returns the best solution
+};
+
+
+/*
+	The hash of a solution is the sum of the hashes of its edges, so it doesn't
+	depend on where the tour starts and it can be updated when few edges change.
+	In symmetric graphs a edge has the same hash in both directions, so a tour and
+	its reverse have the same hash (they are the same solution).
+*/
+inline uint64_t Genetic::edgeHash(int src, int dest) const
+{
+	if(graph->isSymmetric() && src > dest)
+	{
+		int aux = src;
+		src = dest;
+		dest = aux;
+	}
+	
+	// splitmix64 finalizer
+	uint64_t z = (((uint64_t)src << 32) | (uint32_t)dest) + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+#endif